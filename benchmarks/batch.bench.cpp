@@ -0,0 +1,99 @@
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../include/batch.hpp"
+
+// Compares scanning a batch of results for errors when stored as a vector of
+// optional_t against an optional_batch_t.
+
+namespace {
+
+constexpr int element_count = 1 << 20;
+
+// One element in every 1000 contains an error.
+bool failed(int index) {
+    return index % 1000 == 999;
+}
+
+void bm_vector_count_errors(benchmark::State& state) {
+    std::vector<res::optional_t<int>> results;
+    results.reserve(element_count);
+    for (int index = 0; index < element_count; ++index) {
+        if (failed(index)) {
+            results.emplace_back(res::error_t{ "error" });
+        } else {
+            results.emplace_back(index);
+        }
+    }
+
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (const res::optional_t<int>& result : results) {
+            count += result.has_error() ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * element_count);
+}
+BENCHMARK(bm_vector_count_errors);
+
+void bm_batch_count_errors(benchmark::State& state) {
+    res::optional_batch_t<int> batch;
+    batch.reserve(element_count);
+    for (int index = 0; index < element_count; ++index) {
+        if (failed(index)) {
+            batch.push_back(res::error_t{ "error" });
+        } else {
+            batch.push_back(index);
+        }
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(batch.count_errors());
+    }
+    state.SetItemsProcessed(state.iterations() * element_count);
+}
+BENCHMARK(bm_batch_count_errors);
+
+void bm_vector_first_error(benchmark::State& state) {
+    std::vector<res::optional_t<int>> results;
+    results.reserve(element_count);
+    for (int index = 0; index < element_count - 1; ++index) {
+        results.emplace_back(index);
+    }
+    results.emplace_back(res::error_t{ "error" });
+
+    for (auto _ : state) {
+        std::size_t index = 0;
+        while (index < results.size() && results[index].has_value()) {
+            ++index;
+        }
+        benchmark::DoNotOptimize(index);
+    }
+    state.SetItemsProcessed(state.iterations() * element_count);
+}
+BENCHMARK(bm_vector_first_error);
+
+void bm_batch_first_error(benchmark::State& state) {
+    res::optional_batch_t<int> batch;
+    batch.reserve(element_count);
+    for (int index = 0; index < element_count - 1; ++index) {
+        batch.push_back(index);
+    }
+    batch.push_back(res::error_t{ "error" });
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(batch.first_error());
+    }
+    state.SetItemsProcessed(state.iterations() * element_count);
+}
+BENCHMARK(bm_batch_first_error);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../include/optional.hpp"
+
+// Compares a 10-stage pipeline written with combinators against the same
+// pipeline written with explicit has_error() checks, as in
+// examples/optional.cpp.
+
+namespace {
+
+constexpr int stage_count = 10;
+
+res::optional_t<int> stage(int value) {
+    benchmark::DoNotOptimize(value);
+    if (value < 0) {
+        return RES_NEW_ERROR("value cannot be negative");
+    }
+    return value + 1;
+}
+
+res::optional_t<int> handwritten(int value) {
+    auto stage_1 = stage(value);
+    if (stage_1.has_error()) {
+        return RES_TRACE(stage_1.error());
+    }
+    auto stage_2 = stage(stage_1.value());
+    if (stage_2.has_error()) {
+        return RES_TRACE(stage_2.error());
+    }
+    auto stage_3 = stage(stage_2.value());
+    if (stage_3.has_error()) {
+        return RES_TRACE(stage_3.error());
+    }
+    auto stage_4 = stage(stage_3.value());
+    if (stage_4.has_error()) {
+        return RES_TRACE(stage_4.error());
+    }
+    auto stage_5 = stage(stage_4.value());
+    if (stage_5.has_error()) {
+        return RES_TRACE(stage_5.error());
+    }
+    auto stage_6 = stage(stage_5.value());
+    if (stage_6.has_error()) {
+        return RES_TRACE(stage_6.error());
+    }
+    auto stage_7 = stage(stage_6.value());
+    if (stage_7.has_error()) {
+        return RES_TRACE(stage_7.error());
+    }
+    auto stage_8 = stage(stage_7.value());
+    if (stage_8.has_error()) {
+        return RES_TRACE(stage_8.error());
+    }
+    auto stage_9 = stage(stage_8.value());
+    if (stage_9.has_error()) {
+        return RES_TRACE(stage_9.error());
+    }
+    auto stage_10 = stage(stage_9.value());
+    if (stage_10.has_error()) {
+        return RES_TRACE(stage_10.error());
+    }
+    return stage_10;
+}
+
+res::optional_t<int> combinators(int value) {
+    return stage(value)
+      .and_then(stage)
+      .and_then(stage)
+      .and_then(stage)
+      .and_then(stage)
+      .and_then(stage)
+      .and_then(stage)
+      .and_then(stage)
+      .and_then(stage)
+      .and_then(stage, RES_SITE);
+}
+
+void bm_handwritten_success(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = handwritten(0);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_handwritten_success);
+
+void bm_combinators_success(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = combinators(0);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_combinators_success);
+
+// The first stage fails. The handwritten pipeline copies the error once to
+// trace it; the combinators move it through the remaining stages and trace
+// it once at the end.
+void bm_handwritten_failure(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = handwritten(-stage_count);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_handwritten_failure);
+
+void bm_combinators_failure(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = combinators(-stage_count);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_combinators_failure);
+
+} // namespace
+
+BENCHMARK_MAIN();
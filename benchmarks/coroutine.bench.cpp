@@ -0,0 +1,92 @@
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../include/coroutine.hpp"
+
+// Compares propagating errors with co_await against handwritten has_error()
+// checks through three nested calls. On success each coroutine additionally
+// sets up a frame, which GCC does not elide. On failure co_await moves the
+// error along, while the handwritten checks copy it.
+
+namespace {
+
+res::optional_t<int> leaf(int value) {
+    benchmark::DoNotOptimize(value);
+    if (value < 0) {
+        return RES_NEW_ERROR("value cannot be negative");
+    }
+    return value + 1;
+}
+
+res::optional_t<int> handwritten_middle(int value) {
+    auto first = leaf(value);
+    if (first.has_error()) {
+        return RES_TRACE(first.error());
+    }
+    auto second = leaf(first.value());
+    if (second.has_error()) {
+        return RES_TRACE(second.error());
+    }
+    return second.value() + 1;
+}
+
+res::optional_t<int> handwritten(int value) {
+    auto first = handwritten_middle(value);
+    if (first.has_error()) {
+        return RES_TRACE(first.error());
+    }
+    auto second = handwritten_middle(first.value());
+    if (second.has_error()) {
+        return RES_TRACE(second.error());
+    }
+    return second.value() + 1;
+}
+
+res::optional_t<int> coroutine_middle(int value) {
+    const int first = co_await leaf(value);
+    const int second = co_await leaf(first);
+    co_return second + 1;
+}
+
+res::optional_t<int> coroutine(int value) {
+    const int first = co_await coroutine_middle(value);
+    const int second = co_await coroutine_middle(first);
+    co_return second + 1;
+}
+
+void bm_handwritten_success(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = handwritten(0);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_handwritten_success);
+
+void bm_coroutine_success(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = coroutine(0);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_coroutine_success);
+
+void bm_handwritten_failure(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = handwritten(-1);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_handwritten_failure);
+
+void bm_coroutine_failure(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = coroutine(-1);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_coroutine_failure);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+// Standard includes
+#include <future>
+#include <utility>
+#include <vector>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../include/executor.hpp"
+#include "../include/future.hpp"
+
+// Measures the latency of handing a result from a promise to a future, both
+// on one thread and through the executor, compared with std::promise.
+
+namespace {
+
+void bm_promise_ready(benchmark::State& state) {
+    for (auto _ : state) {
+        auto [promise, future] = res::make_promise<int>();
+        (void)promise.set(1);
+        auto result = future.get();
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_promise_ready);
+
+void bm_std_promise_ready(benchmark::State& state) {
+    for (auto _ : state) {
+        std::promise<int> promise;
+        auto future = promise.get_future();
+        promise.set_value(1);
+        auto result = future.get();
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_std_promise_ready);
+
+void bm_executor_round_trip(benchmark::State& state) {
+    res::executor_t executor{ 1 };
+    for (auto _ : state) {
+        auto result =
+          executor.async([] { return res::optional_t<int>{ 1 }; }).get();
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_executor_round_trip)->UseRealTime();
+
+void bm_std_async_round_trip(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = std::async(std::launch::async, [] { return 1; }).get();
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_std_async_round_trip)->UseRealTime();
+
+void bm_when_all(benchmark::State& state) {
+    res::executor_t executor;
+    const auto count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        std::vector<res::future_t<int>> futures;
+        futures.reserve(count);
+        for (int index = 0; index < count; ++index) {
+            futures.push_back(executor.async(
+              [index] { return res::optional_t<int>{ index }; }));
+        }
+        auto result = res::when_all(std::move(futures)).get();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(bm_when_all)->Arg(8)->Arg(64)->Arg(512)->UseRealTime();
+
+void bm_when_all_fail_fast(benchmark::State& state) {
+    res::executor_t executor;
+    const auto count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        res::cancellation_token_t token;
+        std::vector<res::future_t<int>> futures;
+        futures.reserve(count);
+        for (int index = 0; index < count; ++index) {
+            futures.push_back(executor.async(token, [index] {
+                if (index == 0) {
+                    return res::optional_t<int>{ RES_NEW_ERROR("failed") };
+                }
+                return res::optional_t<int>{ index };
+            }));
+        }
+        auto result = res::when_all(std::move(futures), token).get();
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_when_all_fail_fast)->Arg(64)->Arg(512)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+// Standard includes
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../include/memo.hpp"
+
+// Measures memo_cache_t throughput and hit rate under concurrent lookups with a
+// skewed key distribution.
+
+namespace {
+
+constexpr std::uint64_t key_space = 4096;
+
+// An expensive lookup that fails for one key in every eight.
+res::optional_t<std::uint64_t> lookup(const std::uint64_t& key) {
+    std::this_thread::sleep_for(std::chrono::microseconds{ 20 });
+    if (key % 8 == 7) {
+        return RES_NEW_ERROR("lookup failed");
+    }
+    return key * key;
+}
+
+// Maps a uniform random value onto a skewed key so that low keys dominate.
+std::uint64_t skewed_key(std::uint64_t random) {
+    const std::uint64_t uniform = random % key_space;
+    return (uniform * uniform) / key_space;
+}
+
+std::uint64_t next_random(std::uint64_t& state) {
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    return state;
+}
+
+res::memo_cache_t<std::uint64_t, std::uint64_t>& cache() {
+    static res::memo_cache_t<std::uint64_t, std::uint64_t> cache{ lookup };
+    return cache;
+}
+
+void bm_memo_get(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        cache().clear();
+    }
+    std::uint64_t random = 0x9E3779B97F4A7C15ULL + state.thread_index();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache().get(skewed_key(next_random(random))));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        const res::memo_stats_t stats = cache().stats();
+        const double total =
+          static_cast<double>(stats.hits + stats.misses + stats.coalesced);
+        state.counters["hit_rate"] =
+          total == 0 ? 0 : static_cast<double>(stats.hits) / total;
+        state.counters["coalesced"] = static_cast<double>(stats.coalesced);
+    }
+}
+BENCHMARK(bm_memo_get)->ThreadRange(1, 8)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
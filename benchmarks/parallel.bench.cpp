@@ -0,0 +1,126 @@
+// Standard includes
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../include/parallel.hpp"
+
+// Measures how the parallel algorithms scale from one worker thread to the
+// number of hardware threads, and how quickly they stop after a failure.
+
+namespace {
+
+constexpr int element_count = 1 << 20;
+
+const std::vector<int>& elements() {
+    static const std::vector<int> values = [] {
+        std::vector<int> values(element_count);
+        for (int index = 0; index < element_count; ++index) {
+            values[index] = index;
+        }
+        return values;
+    }();
+    return values;
+}
+
+// A fallible operation with enough work to be worth parallelizing.
+res::optional_t<double> work(int value) {
+    if (value < 0) {
+        return RES_NEW_ERROR("value cannot be negative");
+    }
+    double result = value;
+    for (int iteration = 0; iteration < 16; ++iteration) {
+        result = std::sqrt(result + iteration);
+    }
+    return result;
+}
+
+void thread_counts(benchmark::internal::Benchmark* benchmark) {
+    const int hardware_threads =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int threads = 1; threads < hardware_threads; threads *= 2) {
+        benchmark->Arg(threads);
+    }
+    benchmark->Arg(hardware_threads);
+}
+
+void bm_serial_transform(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<double> values;
+        values.reserve(element_count);
+        for (int element : elements()) {
+            auto result = work(element);
+            if (result.has_error()) {
+                break;
+            }
+            values.push_back(result.value());
+        }
+        benchmark::DoNotOptimize(values);
+    }
+    state.SetItemsProcessed(state.iterations() * element_count);
+}
+BENCHMARK(bm_serial_transform)->UseRealTime();
+
+void bm_transform(benchmark::State& state) {
+    res::executor_t executor{ static_cast<std::size_t>(state.range(0)) };
+    for (auto _ : state) {
+        auto result = res::parallel::transform(
+          executor, elements().begin(), elements().end(), work);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * element_count);
+}
+BENCHMARK(bm_transform)->Apply(thread_counts)->UseRealTime();
+
+void bm_for_each(benchmark::State& state) {
+    res::executor_t executor{ static_cast<std::size_t>(state.range(0)) };
+    for (auto _ : state) {
+        auto result = res::parallel::for_each(
+          executor, elements().begin(), elements().end(), [](int element) {
+              auto value = work(element);
+              benchmark::DoNotOptimize(value);
+              return res::result_t{};
+          });
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * element_count);
+}
+BENCHMARK(bm_for_each)->Apply(thread_counts)->UseRealTime();
+
+void bm_transform_reduce(benchmark::State& state) {
+    res::executor_t executor{ static_cast<std::size_t>(state.range(0)) };
+    for (auto _ : state) {
+        auto result = res::parallel::transform_reduce(
+          executor,
+          elements().begin(),
+          elements().end(),
+          0.0,
+          [](double lhs, double rhs) { return lhs + rhs; },
+          work);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * element_count);
+}
+BENCHMARK(bm_transform_reduce)->Apply(thread_counts)->UseRealTime();
+
+// The first element fails, so the remaining work should be skipped.
+void bm_transform_early_failure(benchmark::State& state) {
+    res::executor_t executor{ static_cast<std::size_t>(state.range(0)) };
+    std::vector<int> values = elements();
+    values.front() = -1;
+    for (auto _ : state) {
+        auto result = res::parallel::transform(
+          executor, values.begin(), values.end(), work);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(bm_transform_early_failure)->Apply(thread_counts)->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,390 @@
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// POSIX includes
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Local includes
+#include "../include/optional.hpp"
+
+// Measures how throughput, latency, and allocations of error-heavy workloads
+// scale with the number of threads. Each operation creates a result through a
+// chain of calls, copies it, and either destroys it or hands it off to another
+// thread. Run with --help for the available options.
+
+namespace {
+
+// Allocations are counted per thread so that counting does not add contention.
+thread_local std::uint64_t allocation_count = 0;
+
+struct options_t {
+    unsigned threads = std::max(1U, std::thread::hardware_concurrency());
+    std::size_t operations = 200000;
+    double success = 0.5;
+    unsigned depth = 4;
+    unsigned fanout = 1;
+    double handoff = 0.0;
+    bool pin = true;
+};
+
+struct sample_t {
+    std::chrono::steady_clock::time_point begin;
+    std::chrono::steady_clock::time_point end;
+    std::uint64_t operations = 0;
+    std::uint64_t allocations = 0;
+    std::vector<std::uint32_t> latencies;
+};
+
+struct report_t {
+    unsigned threads = 0;
+    double seconds = 0;
+    std::uint64_t operations = 0;
+    std::uint64_t allocations = 0;
+    std::uint32_t p50 = 0;
+    std::uint32_t p99 = 0;
+};
+
+std::uint64_t next_random(std::uint64_t& state) {
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    return state;
+}
+
+// Returns a value or an error through depth calls, tracing the error at each.
+[[gnu::noinline]] res::optional_t<std::uint64_t> work(
+  unsigned depth, bool success, std::uint64_t value) {
+    if (depth == 0) {
+        if (! success) {
+            return RES_NEW_ERROR("operation failed");
+        }
+        return value;
+    }
+
+    res::optional_t<std::uint64_t> result = work(depth - 1, success, value);
+    if (result.has_error()) {
+        return RES_TRACE(result.error());
+    }
+    return result.value() + 1;
+}
+
+/**
+ * @brief A single-producer, single-consumer ring of results handed off from
+ * one thread to the next.
+ */
+class mailbox_t {
+    static constexpr std::size_t capacity = 1024;
+
+    alignas(64) std::atomic<std::size_t> head_{ 0 };
+    alignas(64) std::atomic<std::size_t> tail_{ 0 };
+    alignas(64) std::unique_ptr<std::optional<res::optional_t<std::uint64_t>>[]>
+      slots_{ new std::optional<res::optional_t<std::uint64_t>>[capacity] };
+
+  public:
+    // Returns false if the mailbox is full.
+    bool push(res::optional_t<std::uint64_t>&& result) {
+        const std::size_t tail = this->tail_.load(std::memory_order_relaxed);
+        if (tail - this->head_.load(std::memory_order_acquire) == capacity) {
+            return false;
+        }
+        this->slots_[tail % capacity].emplace(std::move(result));
+        this->tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Inspect and destroy every result in the mailbox.
+    std::uint64_t drain() {
+        std::uint64_t checksum = 0;
+        std::size_t head = this->head_.load(std::memory_order_relaxed);
+        const std::size_t tail = this->tail_.load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            std::optional<res::optional_t<std::uint64_t>>& slot =
+              this->slots_[head % capacity];
+            checksum += slot->has_value() ? slot->value() : 1;
+            slot.reset();
+        }
+        this->head_.store(head, std::memory_order_release);
+        return checksum;
+    }
+};
+
+// Returns the CPUs this process may run on, which may be fewer than the
+// hardware has (e.g. under taskset or in a container).
+std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
+void pin_thread(const std::vector<int>& cpus, unsigned index) {
+#if defined(__linux__)
+    if (cpus.empty()) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpus[index % cpus.size()], &set);
+    (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpus;
+    (void)index;
+#endif
+}
+
+struct shared_t {
+    std::vector<mailbox_t> mailboxes;
+    std::vector<int> cpus;
+    std::atomic<unsigned> ready{ 0 };
+    std::atomic<unsigned> finished{ 0 };
+};
+
+void run_thread(const options_t& options, unsigned index, unsigned threads,
+  shared_t& shared, sample_t& sample) {
+    if (options.pin) {
+        pin_thread(shared.cpus, index);
+    }
+
+    std::uint64_t random = 0x9E3779B97F4A7C15ULL * (index + 1);
+    const auto success_threshold =
+      static_cast<std::uint64_t>(options.success * 1000000.0);
+    const auto handoff_threshold =
+      static_cast<std::uint64_t>(options.handoff * 1000000.0);
+    mailbox_t& outbox = shared.mailboxes[(index + 1) % threads];
+    mailbox_t& inbox = shared.mailboxes[index];
+    sample.latencies.reserve(options.operations);
+    std::uint64_t checksum = 0;
+
+    shared.ready.fetch_add(1);
+    while (shared.ready.load() != threads) {
+        std::this_thread::yield();
+    }
+
+    sample.begin = std::chrono::steady_clock::now();
+    const std::uint64_t allocations_before = allocation_count;
+    for (std::size_t operation = 0; operation < options.operations;
+      ++operation) {
+        const bool success = next_random(random) % 1000000 < success_threshold;
+        const bool handoff = next_random(random) % 1000000 < handoff_threshold;
+        const auto begin = std::chrono::steady_clock::now();
+
+        res::optional_t<std::uint64_t> result =
+          work(options.depth, success, operation);
+        for (unsigned copy = 0; copy < options.fanout; ++copy) {
+            const res::optional_t<std::uint64_t> copied = result;
+            checksum += copied.has_value() ? 0 : 1;
+        }
+        // Wait for the next thread to make room. The inbox is drained while
+        // waiting so that threads waiting on each other cannot deadlock.
+        if (handoff) {
+            while (! outbox.push(std::move(result))) {
+                checksum += inbox.drain();
+                std::this_thread::yield();
+            }
+        }
+        if ((operation % 64) == 0) {
+            checksum += inbox.drain();
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        sample.latencies.push_back(static_cast<std::uint32_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+            .count()));
+    }
+    sample.end = std::chrono::steady_clock::now();
+    sample.allocations = allocation_count - allocations_before;
+    sample.operations = options.operations;
+
+    // Keep draining until every thread is finished, since the previous thread
+    // may be waiting for room in the inbox.
+    shared.finished.fetch_add(1);
+    while (shared.finished.load() != threads) {
+        checksum += inbox.drain();
+        std::this_thread::yield();
+    }
+    checksum += inbox.drain();
+
+    if (checksum == 0xFFFFFFFFFFFFFFFFULL) {
+        std::puts("");
+    }
+}
+
+report_t run(const options_t& options, unsigned threads) {
+    shared_t shared{ std::vector<mailbox_t>(threads), allowed_cpus() };
+    std::vector<sample_t> samples(threads);
+
+    std::vector<std::thread> workers;
+    for (unsigned index = 0; index < threads; ++index) {
+        workers.emplace_back([&, index] {
+            run_thread(options, index, threads, shared, samples[index]);
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Thread creation and the start barrier are excluded from the time.
+    auto begin = samples.front().begin;
+    auto end = samples.front().end;
+    for (const sample_t& sample : samples) {
+        begin = std::min(begin, sample.begin);
+        end = std::max(end, sample.end);
+    }
+
+    report_t report;
+    report.threads = threads;
+    report.seconds = std::chrono::duration<double>(end - begin).count();
+    std::vector<std::uint32_t> latencies;
+    for (const sample_t& sample : samples) {
+        report.operations += sample.operations;
+        report.allocations += sample.allocations;
+        latencies.insert(
+          latencies.end(), sample.latencies.begin(), sample.latencies.end());
+    }
+    if (! latencies.empty()) {
+        const auto percentile = [&latencies](std::size_t percent) {
+            const std::size_t index = (latencies.size() - 1) * percent / 100;
+            std::nth_element(latencies.begin(),
+              latencies.begin() + static_cast<std::ptrdiff_t>(index),
+              latencies.end());
+            return latencies[index];
+        };
+        report.p50 = percentile(50);
+        report.p99 = percentile(99);
+    }
+    return report;
+}
+
+bool parse_option(std::string_view argument, options_t& options) {
+    const std::size_t equals = argument.find('=');
+    if (argument.substr(0, 2) != "--" || equals == std::string_view::npos) {
+        return false;
+    }
+    const std::string_view name = argument.substr(2, equals - 2);
+    const std::string value{ argument.substr(equals + 1) };
+    char* end = nullptr;
+
+    if (name == "threads") {
+        options.threads =
+          static_cast<unsigned>(std::strtoul(value.c_str(), &end, 10));
+    } else if (name == "operations") {
+        options.operations = std::strtoull(value.c_str(), &end, 10);
+    } else if (name == "success") {
+        options.success = std::strtod(value.c_str(), &end);
+    } else if (name == "depth") {
+        options.depth =
+          static_cast<unsigned>(std::strtoul(value.c_str(), &end, 10));
+    } else if (name == "fanout") {
+        options.fanout =
+          static_cast<unsigned>(std::strtoul(value.c_str(), &end, 10));
+    } else if (name == "handoff") {
+        options.handoff = std::strtod(value.c_str(), &end);
+    } else if (name == "pin") {
+        options.pin = (value != "0" && value != "false");
+        return true;
+    } else {
+        return false;
+    }
+    return end != nullptr && *end == '\0' && ! value.empty();
+}
+
+void print_usage(const char* program) {
+    std::printf(
+      "Usage: %s [--option=value]...\n"
+      "  --threads=N      maximum thread count (powers of two up to N)\n"
+      "  --operations=N   operations per thread\n"
+      "  --success=R      fraction of operations that succeed (0 to 1)\n"
+      "  --depth=N        calls each result propagates through\n"
+      "  --fanout=N       copies made of each result\n"
+      "  --handoff=R      fraction of results destroyed by another thread\n"
+      "  --pin=BOOL       pin each thread to an allowed core\n",
+      program);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*unused*/) noexcept {
+    std::free(pointer);
+}
+
+int main(int argc, char** argv) {
+    options_t options;
+    for (int index = 1; index < argc; ++index) {
+        if (! parse_option(argv[index], options)) {
+            print_usage(argv[0]);
+            return (std::strcmp(argv[index], "--help") == 0) ? EXIT_SUCCESS
+                                                             : EXIT_FAILURE;
+        }
+    }
+    if (options.threads == 0 || options.operations == 0) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("success=%.2f depth=%u fanout=%u handoff=%.2f pin=%d\n",
+      options.success, options.depth, options.fanout, options.handoff,
+      options.pin ? 1 : 0);
+    std::printf("%8s %14s %10s %10s %10s %10s\n", "threads", "ops/s",
+      "scaling", "p50 ns", "p99 ns", "allocs/op");
+
+    double single_throughput = 0;
+    for (unsigned threads = 1;; threads *= 2) {
+        threads = std::min(threads, options.threads);
+        const report_t report = run(options, threads);
+        const double throughput =
+          static_cast<double>(report.operations) / report.seconds;
+        if (threads == 1) {
+            single_throughput = throughput;
+        }
+
+        // Scaling is the throughput relative to perfect linear scaling.
+        std::printf("%8u %14.0f %10.2f %10u %10u %10.2f\n", threads,
+          throughput, throughput / (single_throughput * threads), report.p50,
+          report.p99,
+          static_cast<double>(report.allocations)
+            / static_cast<double>(report.operations));
+
+        if (threads == options.threads) {
+            break;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,50 @@
+// Standard includes
+#include <string>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../include/optional.hpp"
+#include "../include/stack.hpp"
+
+// Measures the cost of creating an error with and without native stack capture
+// and the cost of rendering a captured stack.
+
+namespace {
+
+[[gnu::noinline]] res::optional_t<int> fail(int depth) {
+    if (depth == 0) {
+        return RES_NEW_ERROR("error");
+    }
+    auto result = fail(depth - 1);
+    benchmark::DoNotOptimize(result);
+    return result;
+}
+
+// 0: capture disabled, 1: _Unwind_Backtrace, 2: frame pointer walk.
+void bm_new_error(benchmark::State& state) {
+    res::enable_stack_capture(state.range(0) != 0,
+      (state.range(0) == 2) ? res::stack_walk_t::frame_pointers
+                            : res::stack_walk_t::unwind);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fail(8));
+    }
+    res::enable_stack_capture(false);
+}
+BENCHMARK(bm_new_error)->Arg(0)->Arg(1)->Arg(2);
+
+void bm_render_stack(benchmark::State& state) {
+    res::enable_stack_capture();
+    const res::error_t error = fail(8).error();
+    res::enable_stack_capture(false);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(res::render_stack(error));
+    }
+}
+BENCHMARK(bm_render_stack);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,34 @@
+// Standard includes
+#include <cstdint>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../include/error.hpp"
+
+// Measures the cost of appending a frame to an error whose trace is bounded
+// and already full, for different numbers of retained last frames.
+
+namespace {
+
+void bm_bounded_trace(benchmark::State& state) {
+    const auto last = static_cast<std::uint32_t>(state.range(0));
+    res::set_trace_limit(res::trace_limit_t{ 2, last });
+
+    res::error_t error = RES_NEW_ERROR("origin");
+    for (std::uint32_t frame = 0; frame < 2 * last + 2; ++frame) {
+        res::append_trace(error, RES_SITE);
+    }
+
+    for (auto _ : state) {
+        res::append_trace(error, RES_SITE);
+        benchmark::DoNotOptimize(error);
+    }
+    res::set_trace_limit(res::trace_limit_t{});
+}
+BENCHMARK(bm_bounded_trace)->Arg(3)->Arg(1000)->Arg(100000);
+
+} // namespace
+
+BENCHMARK_MAIN();
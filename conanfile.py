@@ -35,7 +35,10 @@ class cpp_result(ConanFile):
         os.path.join("include", "*"),
         os.path.join("tests", "*"),
         os.path.join("examples", "*"),
+        os.path.join("src", "*"),
+        os.path.join("benchmarks", "*"),
         "meson.build",
+        "meson_options.txt",
     )
 
     def set_version(self):
@@ -0,0 +1,34 @@
+// Standard includes
+#include <iostream>
+#include <vector>
+
+// External includes
+#include "../include/serialize.hpp"
+
+int main() {
+    auto error = RES_NEW_ERROR("This error is sent to another process.");
+    error = RES_TRACE(error);
+
+    // Errors are encoded into a buffer supplied by the caller.
+    std::vector<unsigned char> buffer(res::encoded_size(error));
+    auto size = res::encode(error, buffer.data(), buffer.size());
+    if (size.has_error()) {
+        std::cout << size.error() << '\n';
+        return 1;
+    }
+
+    // The receiver reads the encoded error in place without copying it.
+    res::error_view_t view;
+    auto result = view.read(buffer.data(), size.value());
+    if (result.failure()) {
+        std::cout << result.error() << '\n';
+        return 1;
+    }
+
+    for (const res::frame_t frame : view) {
+        std::cout << frame.file << ':' << frame.line << " " << frame.message
+                  << '\n';
+    }
+
+    std::cout << view;
+}
@@ -33,3 +33,11 @@
 #include "error.hpp"
 #include "result.hpp"
 #include "optional.hpp"
+#include "trace.hpp"
+#include "serialize.hpp"
+#include "batch.hpp"
+#include "static.hpp"
+
+// The following headers are opt-in since they depend on threads, coroutines, or
+// POSIX, and must be included directly: coroutine.hpp, executor.hpp,
+// future.hpp, journal.hpp, memo.hpp, parallel.hpp, stack.hpp, and timeline.hpp.
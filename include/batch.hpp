@@ -0,0 +1,418 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file batch.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief A structure-of-arrays container for many optional results.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if __has_include(<bit>)
+#include <bit>
+#endif
+
+// Local includes
+#include "error.hpp"
+#include "optional.hpp"
+
+namespace res {
+
+namespace detail {
+
+[[nodiscard]] inline int popcount(std::uint64_t word) {
+#if defined(__cpp_lib_bitops)
+    return std::popcount(word);
+#elif defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word != 0; word &= word - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// The word must not be zero.
+[[nodiscard]] inline int countr_zero(std::uint64_t word) {
+#if defined(__cpp_lib_bitops)
+    return std::countr_zero(word);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int count = 0;
+    for (; (word & 1) == 0; word >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Stores many optional results as a structure of arrays. Values are
+ * stored contiguously, whether each element contains a value is stored in a
+ * packed bitmap, and errors are stored in a sparse table sorted by index.
+ * Scanning for errors only reads the bitmap, one bit per element.
+ *
+ * Elements containing an error still occupy a default constructed value, so
+ * the value type must be default constructible.
+ */
+template<typename type_t>
+class optional_batch_t {
+    static_assert(std::is_default_constructible_v<type_t>,
+      "optional_batch_t requires a default constructible value type.");
+
+    static constexpr std::size_t word_bits = 64;
+
+    std::vector<type_t> values_;
+    // Bit i is set if element i contains a value. Bits past the end are zero.
+    std::vector<std::uint64_t> valid_;
+    std::vector<std::pair<std::size_t, error_t>> errors_;
+
+    static inline const error_t has_value_error{ "Has value" };
+    static inline const std::string bad_access_message{
+        "Attempted to access a value from an optional_batch_t element that "
+        "does not exist."
+    };
+
+    void set_valid_(std::size_t index, bool valid) {
+        const std::uint64_t bit = std::uint64_t{ 1 } << (index % word_bits);
+        if (valid) {
+            this->valid_[index / word_bits] |= bit;
+        } else {
+            this->valid_[index / word_bits] &= ~bit;
+        }
+    }
+
+    void grow_() {
+        if (this->values_.size() % word_bits == 0) {
+            this->valid_.push_back(0);
+        }
+        this->values_.emplace_back();
+    }
+
+    [[nodiscard]] auto find_error_(std::size_t index) const {
+        return std::lower_bound(this->errors_.begin(),
+          this->errors_.end(),
+          index,
+          [](const auto& entry, std::size_t key) { return entry.first < key; });
+    }
+
+    [[nodiscard]] auto find_error_(std::size_t index) {
+        return std::lower_bound(this->errors_.begin(),
+          this->errors_.end(),
+          index,
+          [](const auto& entry, std::size_t key) { return entry.first < key; });
+    }
+
+    void erase_error_(std::size_t index) {
+        auto entry = this->find_error_(index);
+        if (entry != this->errors_.end() && entry->first == index) {
+            this->errors_.erase(entry);
+        }
+    }
+
+  public:
+    // A reference to a value, or a copy for std::vector<bool>, whose elements
+    // are not addressable.
+    using const_reference = typename std::vector<type_t>::const_reference;
+
+    /**
+     * @brief A lightweight view of one element of a batch.
+     */
+    class element_t {
+        const optional_batch_t* batch_;
+        std::size_t index_;
+
+      public:
+        element_t(const optional_batch_t& batch, std::size_t index)
+        : batch_(&batch), index_(index) {
+        }
+
+        [[nodiscard]] std::size_t index() const {
+            return this->index_;
+        }
+
+        [[nodiscard]] bool has_value() const {
+            return this->batch_->has_value(this->index_);
+        }
+
+        [[nodiscard]] bool has_error() const {
+            return this->batch_->has_error(this->index_);
+        }
+
+        [[nodiscard]] const_reference value() const {
+            return this->batch_->value(this->index_);
+        }
+
+        [[nodiscard]] error_t error() const {
+            return this->batch_->error(this->index_);
+        }
+    };
+
+    /**
+     * @brief Iterates over views of the elements of a batch.
+     */
+    class iterator_t {
+        const optional_batch_t* batch_;
+        std::size_t index_;
+
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = element_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = element_t;
+
+        iterator_t(const optional_batch_t& batch, std::size_t index)
+        : batch_(&batch), index_(index) {
+        }
+
+        [[nodiscard]] element_t operator*() const {
+            return element_t{ *(this->batch_), this->index_ };
+        }
+
+        iterator_t& operator++() {
+            ++this->index_;
+            return *this;
+        }
+
+        iterator_t operator++(int) {
+            iterator_t copy = *this;
+            ++this->index_;
+            return copy;
+        }
+
+        [[nodiscard]] bool operator==(const iterator_t& other) const {
+            return this->index_ == other.index_;
+        }
+
+        [[nodiscard]] bool operator!=(const iterator_t& other) const {
+            return this->index_ != other.index_;
+        }
+    };
+
+    optional_batch_t() = default;
+
+    /**
+     * @brief Reserve space for a number of elements.
+     */
+    void reserve(std::size_t capacity) {
+        this->values_.reserve(capacity);
+        this->valid_.reserve((capacity + word_bits - 1) / word_bits);
+    }
+
+    /**
+     * @return the number of elements.
+     */
+    [[nodiscard]] std::size_t size() const {
+        return this->values_.size();
+    }
+
+    /**
+     * @return true if there are no elements and false otherwise.
+     */
+    [[nodiscard]] bool empty() const {
+        return this->values_.empty();
+    }
+
+    /**
+     * @brief Remove all elements.
+     */
+    void clear() {
+        this->values_.clear();
+        this->valid_.clear();
+        this->errors_.clear();
+    }
+
+    /**
+     * @brief Append an element containing a value.
+     */
+    void push_back(const type_t& value) {
+        this->grow_();
+        this->values_.back() = value;
+        this->set_valid_(this->size() - 1, true);
+    }
+    void push_back(type_t&& value) {
+        this->grow_();
+        this->values_.back() = std::move(value);
+        this->set_valid_(this->size() - 1, true);
+    }
+
+    /**
+     * @brief Append an element containing an error.
+     */
+    void push_back(const error_t& error) {
+        this->grow_();
+        this->errors_.emplace_back(this->size() - 1, error);
+    }
+    void push_back(error_t&& error) {
+        this->grow_();
+        this->errors_.emplace_back(this->size() - 1, std::move(error));
+    }
+
+    /**
+     * @brief Append an element containing the value or error of an
+     * optional_t.
+     */
+    void push_back(const optional_t<type_t>& optional) {
+        if (optional.has_value()) {
+            this->push_back(optional.value());
+        } else {
+            this->push_back(optional.error_ref());
+        }
+    }
+    void push_back(optional_t<type_t>&& optional) {
+        if (optional.has_value()) {
+            this->push_back(std::move(optional.value()));
+        } else {
+            this->push_back(
+              std::move(*(detail::access_t::take_error(optional))));
+        }
+    }
+
+    /**
+     * @brief Replace an element with a value.
+     */
+    void set(std::size_t index, type_t value) {
+        if (! this->has_value(index)) {
+            this->erase_error_(index);
+            this->set_valid_(index, true);
+        }
+        this->values_[index] = std::move(value);
+    }
+
+    /**
+     * @brief Replace an element with an error.
+     */
+    void set(std::size_t index, error_t error) {
+        if (this->has_value(index)) {
+            this->set_valid_(index, false);
+            this->values_[index] = type_t{};
+            this->errors_.emplace(
+              this->find_error_(index), index, std::move(error));
+            return;
+        }
+        this->find_error_(index)->second = std::move(error);
+    }
+
+    /**
+     * @return true if an element contains a value and false otherwise.
+     */
+    [[nodiscard]] bool has_value(std::size_t index) const {
+        return ((this->valid_[index / word_bits] >> (index % word_bits)) & 1)
+          != 0;
+    }
+
+    /**
+     * @return true if an element contains an error and false otherwise.
+     */
+    [[nodiscard]] bool has_error(std::size_t index) const {
+        return ! this->has_value(index);
+    }
+
+    /**
+     * @throw bad_optional_access_t if the element does not contain a value.
+     * @return a reference to the value of an element (a copy for bool).
+     */
+    [[nodiscard]] const_reference value(std::size_t index) const {
+        if (! this->has_value(index)) {
+            throw bad_optional_access_t{ RES_ERROR(
+              this->error(index), bad_access_message) };
+        }
+        return this->values_[index];
+    }
+
+    /**
+     * @return a copy of the error of an element or a generic success message
+     * if the element does not contain an error.
+     */
+    [[nodiscard]] error_t error(std::size_t index) const {
+        if (this->has_value(index)) {
+            return has_value_error;
+        }
+        return this->find_error_(index)->second;
+    }
+
+    /**
+     * @return the number of elements containing an error. The loop over the
+     * bitmap has no branches, so compilers can vectorize it.
+     */
+    [[nodiscard]] std::size_t count_errors() const {
+        std::size_t valid = 0;
+        for (const std::uint64_t word : this->valid_) {
+            valid += static_cast<std::size_t>(detail::popcount(word));
+        }
+        return this->size() - valid;
+    }
+
+    /**
+     * @return the index of the first element containing an error, or size()
+     * if there are none.
+     */
+    [[nodiscard]] std::size_t first_error() const {
+        for (std::size_t word = 0; word < this->valid_.size(); ++word) {
+            const std::uint64_t invalid = ~(this->valid_[word]);
+            if (invalid != 0) {
+                const std::size_t index = word * word_bits
+                  + static_cast<std::size_t>(detail::countr_zero(invalid));
+                return std::min(index, this->size());
+            }
+        }
+        return this->size();
+    }
+
+    /**
+     * @return the values of all elements in order. Elements containing an
+     * error hold a default constructed value.
+     */
+    [[nodiscard]] const std::vector<type_t>& values() const {
+        return this->values_;
+    }
+
+    [[nodiscard]] element_t operator[](std::size_t index) const {
+        return element_t{ *this, index };
+    }
+
+    [[nodiscard]] iterator_t begin() const {
+        return iterator_t{ *this, 0 };
+    }
+
+    [[nodiscard]] iterator_t end() const {
+        return iterator_t{ *this, this->size() };
+    }
+};
+
+} // namespace res
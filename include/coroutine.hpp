@@ -0,0 +1,441 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file coroutine.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief C++20 coroutine support for optional_t and result_t.
+ * @date 2026-10-19
+ */
+
+// Functions returning optional_t or result_t become coroutines when they use
+// co_await or co_return. Awaiting an optional_t or result_t that contains an
+// error returns the error from the coroutine immediately with a trace for the
+// co_await expression appended. Otherwise co_await evaluates to the value.
+//
+// res::optional_t<int> sum(std::string_view lhs, std::string_view rhs) {
+//     const int left = co_await parse(lhs);
+//     const int right = co_await parse(rhs);
+//     co_return left + right;
+// }
+//
+// These coroutines never suspend, so their frames never outlive the call and
+// compilers that elide coroutine allocations can place them on the stack.
+// Frames that are allocated are recycled through a small per-thread cache.
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#define RES_HAS_COROUTINES 1
+
+// Standard includes
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#if __has_include(<source_location>)
+#include <source_location>
+#endif
+
+// Local includes
+#include "error.hpp"
+#include "optional.hpp"
+#include "result.hpp"
+
+namespace res::detail {
+
+/**
+ * @brief Recycles coroutine frames freed on the current thread. Frames are
+ * grouped by size in 64 byte increments.
+ */
+class frame_cache_t {
+    static constexpr std::size_t granularity = 64;
+    static constexpr std::size_t bucket_count = 16;
+    static constexpr std::size_t bucket_capacity = 8;
+
+    struct node_t {
+        node_t* next;
+    };
+
+    node_t* buckets_[bucket_count] = {};
+    std::size_t counts_[bucket_count] = {};
+
+  public:
+    frame_cache_t() = default;
+    frame_cache_t(const frame_cache_t&) = delete;
+    frame_cache_t(frame_cache_t&&) = delete;
+    frame_cache_t& operator=(const frame_cache_t&) = delete;
+    frame_cache_t& operator=(frame_cache_t&&) = delete;
+
+    ~frame_cache_t() {
+        for (node_t*& bucket : this->buckets_) {
+            while (bucket != nullptr) {
+                ::operator delete(std::exchange(bucket, bucket->next));
+            }
+        }
+    }
+
+    [[nodiscard]] void* allocate(std::size_t size) {
+        const std::size_t bucket = (size - 1) / granularity;
+        if (bucket >= bucket_count) {
+            return ::operator new(size);
+        }
+
+        if (this->buckets_[bucket] != nullptr) {
+            --this->counts_[bucket];
+            return std::exchange(
+              this->buckets_[bucket], this->buckets_[bucket]->next);
+        }
+        return ::operator new((bucket + 1) * granularity);
+    }
+
+    void deallocate(void* frame, std::size_t size) {
+        const std::size_t bucket = (size - 1) / granularity;
+        if (bucket >= bucket_count
+          || this->counts_[bucket] == bucket_capacity) {
+            ::operator delete(frame);
+            return;
+        }
+
+        ++this->counts_[bucket];
+        this->buckets_[bucket] =
+          ::new (frame) node_t{ this->buckets_[bucket] };
+    }
+};
+
+inline frame_cache_t& frame_cache() {
+    thread_local frame_cache_t cache;
+    return cache;
+}
+
+#if defined(__cpp_lib_source_location)
+
+/**
+ * @brief Reduce a function signature to its unqualified name to match the
+ * output of __FUNCTION__. Lambdas are named "operator()".
+ */
+constexpr std::string_view function_name(std::string_view signature) {
+    // GCC appends the template arguments and names lambdas
+    // "enclosing()::<lambda(parameters)>".
+    signature = signature.substr(0, signature.find(" [with "));
+    if (! signature.empty() && signature.back() == '>') {
+        return "operator()";
+    }
+
+    // Remove the parameter list, which begins at the parenthesis matching the
+    // last one, and anything following it.
+    std::size_t open = signature.rfind(')');
+    if (open != std::string_view::npos) {
+        std::size_t depth = 0;
+        for (; open != std::string_view::npos; --open) {
+            if (signature[open] == ')') {
+                ++depth;
+            } else if (signature[open] == '(' && --depth == 0) {
+                break;
+            }
+        }
+        signature = signature.substr(0, open);
+    }
+
+    // Operator names may contain spaces, brackets, and parentheses.
+    constexpr std::string_view keyword = "operator";
+    std::size_t begin = signature.rfind(keyword);
+    while (begin != std::string_view::npos) {
+        const std::size_t end = begin + keyword.size();
+        const bool starts = begin == 0 || signature[begin - 1] == ':'
+          || signature[begin - 1] == ' ';
+        const bool ends = end == signature.size() || signature[end] == ' '
+          || ! ((signature[end] >= 'a' && signature[end] <= 'z')
+            || (signature[end] >= 'A' && signature[end] <= 'Z')
+            || (signature[end] >= '0' && signature[end] <= '9')
+            || signature[end] == '_');
+        if (starts && ends) {
+            return signature.substr(begin);
+        }
+        begin = (begin == 0) ? std::string_view::npos
+                             : signature.rfind(keyword, begin - 1);
+    }
+
+    // Otherwise the name follows the last scope separator or the return type.
+    begin = signature.find_last_of(" :");
+    return (begin == std::string_view::npos) ? signature
+                                             : signature.substr(begin + 1);
+}
+
+/**
+ * @brief Reduce the signature of a function to its name once per thread and
+ * function. Each function has a single signature string, so the cache is keyed
+ * by its address.
+ */
+inline std::string_view cached_function_name(const char* signature) {
+    struct entry_t {
+        const char* signature = nullptr;
+        std::string_view name;
+    };
+    thread_local std::array<entry_t, 64> cache{};
+
+    entry_t& entry =
+      cache[(reinterpret_cast<std::uintptr_t>(signature) >> 4U) % cache.size()];
+    if (entry.signature != signature) {
+        entry = entry_t{ signature, function_name(signature) };
+    }
+    return entry.name;
+}
+
+using location_t = std::source_location;
+
+inline site_t make_site(const location_t& location) {
+    return site_t{ location.file_name(),
+        cached_function_name(location.function_name()),
+        location.line() };
+}
+
+#define RES_DETAIL_LOCATION                                                    \
+    , location_t location = location_t::current()
+
+#else
+
+struct location_t {};
+
+constexpr site_t make_site(const location_t& /*unused*/) {
+    return site_t{};
+}
+
+#define RES_DETAIL_LOCATION , location_t location = location_t{}
+
+#endif
+
+template<typename returned_t>
+class coroutine_promise_t;
+
+/**
+ * @brief Returned by get_return_object() and converted to returned_t. Some
+ * compilers convert it before the coroutine body runs, in which case the
+ * promise writes its result directly into the converted object. Others
+ * convert it after the coroutine completes, in which case the promise writes
+ * its result here first.
+ */
+template<typename returned_t>
+class coroutine_return_t {
+    coroutine_promise_t<returned_t>* promise_;
+    std::optional<returned_t> storage_;
+
+    friend class coroutine_promise_t<returned_t>;
+
+  public:
+    explicit coroutine_return_t(coroutine_promise_t<returned_t>* promise)
+    : promise_(promise) {
+        promise->proxy_ = this;
+    }
+
+    // The promise refers to this object by address, so it must never move.
+    coroutine_return_t(const coroutine_return_t&) = delete;
+    coroutine_return_t(coroutine_return_t&&) = delete;
+    coroutine_return_t& operator=(const coroutine_return_t&) = delete;
+    coroutine_return_t& operator=(coroutine_return_t&&) = delete;
+    ~coroutine_return_t() = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator returned_t() {
+        if (this->storage_.has_value()) {
+            return std::move(*(this->storage_));
+        }
+        return access_t::link<returned_t>(&(this->promise_->target_));
+    }
+};
+
+/**
+ * @brief Suspends the awaiting coroutine only to return an error from it.
+ *
+ * @tparam awaited_t - The optional_t or result_t being awaited, which may be
+ * const.
+ * @tparam owned - True if the awaited object may be moved from.
+ */
+template<typename awaited_t, bool owned, typename returned_t>
+class awaiter_t {
+    awaited_t& awaited_;
+    // The site is only formatted if an error is returned.
+    location_t location_;
+
+    [[nodiscard]] bool ready_() const {
+        if constexpr (std::is_same_v<std::remove_const_t<awaited_t>,
+                        result_t>) {
+            return this->awaited_.success();
+        } else {
+            return this->awaited_.has_value();
+        }
+    }
+
+  public:
+    awaiter_t(awaited_t& awaited, const location_t& location)
+    : awaited_(awaited), location_(location) {
+    }
+
+    [[nodiscard]] bool await_ready() const {
+        return this->ready_();
+    }
+
+    void await_suspend(
+      std::coroutine_handle<coroutine_promise_t<returned_t>> handle) {
+        std::unique_ptr<error_t> error;
+        if constexpr (owned) {
+            error = access_t::take_error(this->awaited_);
+        } else {
+            error = std::make_unique<error_t>(this->awaited_.error());
+        }
+
+        handle.promise().set(
+          propagate<returned_t>(std::move(error), make_site(this->location_)));
+
+        // The coroutine never resumes. Destroying it here ends the call.
+        handle.destroy();
+    }
+
+    decltype(auto) await_resume() {
+        using value_t = typename awaited_t::value_type;
+        if constexpr (std::is_void_v<value_t>) {
+            return;
+        } else if constexpr (owned && ! std::is_reference_v<value_t>) {
+            // The awaited temporary is destroyed at the end of the full
+            // expression, so a reference into it would dangle in a range-for
+            // or an auto&& binding. Move the value out instead.
+            return static_cast<value_t>(std::move(this->awaited_.value()));
+        } else {
+            return this->awaited_.value();
+        }
+    }
+};
+
+/**
+ * @brief The promise type of coroutines returning optional_t or result_t.
+ */
+template<typename returned_t>
+class coroutine_promise_t {
+    returned_t* target_ = nullptr;
+    coroutine_return_t<returned_t>* proxy_ = nullptr;
+
+    friend class coroutine_return_t<returned_t>;
+
+  public:
+    [[nodiscard]] static void* operator new(std::size_t size) {
+        return frame_cache().allocate(size);
+    }
+
+    static void operator delete(void* frame, std::size_t size) {
+        frame_cache().deallocate(frame, size);
+    }
+
+    [[nodiscard]] coroutine_return_t<returned_t> get_return_object() {
+        return coroutine_return_t<returned_t>{ this };
+    }
+
+    [[nodiscard]] std::suspend_never initial_suspend() const noexcept {
+        return {};
+    }
+
+    [[nodiscard]] std::suspend_never final_suspend() const noexcept {
+        return {};
+    }
+
+    void unhandled_exception() const {
+        throw;
+    }
+
+    /**
+     * @brief Store the result of the coroutine wherever the returned object
+     * currently lives.
+     */
+    template<typename value_t>
+    void set(value_t&& value) {
+        if (this->target_ != nullptr) {
+            *(this->target_) = std::forward<value_t>(value);
+        } else {
+            this->proxy_->storage_.emplace(std::forward<value_t>(value));
+        }
+    }
+
+    template<typename value_t>
+    void return_value(value_t&& value) {
+        this->set(std::forward<value_t>(value));
+    }
+
+    template<typename value_t>
+    [[nodiscard]] auto await_transform(
+      optional_t<value_t>&& awaited RES_DETAIL_LOCATION) {
+        return awaiter_t<optional_t<value_t>, true, returned_t>{
+            awaited, location
+        };
+    }
+
+    template<typename value_t>
+    [[nodiscard]] auto await_transform(
+      optional_t<value_t>& awaited RES_DETAIL_LOCATION) {
+        return awaiter_t<optional_t<value_t>, false, returned_t>{
+            awaited, location
+        };
+    }
+
+    template<typename value_t>
+    [[nodiscard]] auto await_transform(
+      const optional_t<value_t>& awaited RES_DETAIL_LOCATION) {
+        return awaiter_t<const optional_t<value_t>, false, returned_t>{
+            awaited, location
+        };
+    }
+
+    [[nodiscard]] auto await_transform(result_t&& awaited RES_DETAIL_LOCATION) {
+        return awaiter_t<result_t, true, returned_t>{ awaited, location };
+    }
+
+    [[nodiscard]] auto await_transform(result_t& awaited RES_DETAIL_LOCATION) {
+        return awaiter_t<result_t, false, returned_t>{ awaited, location };
+    }
+
+    [[nodiscard]] auto await_transform(
+      const result_t& awaited RES_DETAIL_LOCATION) {
+        return awaiter_t<const result_t, false, returned_t>{
+            awaited, location
+        };
+    }
+};
+
+#undef RES_DETAIL_LOCATION
+
+} // namespace res::detail
+
+template<typename type_t, typename... args_t>
+struct std::coroutine_traits<res::optional_t<type_t>, args_t...> {
+    using promise_type =
+      res::detail::coroutine_promise_t<res::optional_t<type_t>>;
+};
+
+template<typename... args_t>
+struct std::coroutine_traits<res::result_t, args_t...> {
+    using promise_type = res::detail::coroutine_promise_t<res::result_t>;
+};
+
+#endif
@@ -29,34 +29,46 @@
  */
 
 // Standard includes
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-namespace {
+// Local includes
+#include "probe.hpp"
 
-/**
- * @brief Remove the last character in a given string.
- * The string must be non-empty.
- */
-std::string& remove_last(std::string& str) {
-    str.pop_back();
-    return str;
-}
+// Members of error_t are constexpr where std::string and std::vector are
+// (C++20).
+#if defined(__cpp_lib_constexpr_string)                                        \
+  && __cpp_lib_constexpr_string >= 201907L                                     \
+  && defined(__cpp_lib_constexpr_vector)
+#define RES_CONSTEXPR_STRING constexpr
+#else
+#define RES_CONSTEXPR_STRING
+#endif
 
-} // namespace
+// The location where an error macro is expanded.
+#define RES_SITE (res::site_t{ __FILE__, __FUNCTION__, __LINE__ })
 
 // Append a trace to an error. Each trace contains the file name, function name,
 // and line number where this macro is expanded.
-#define RES_TRACE(trace)                                                       \
-    res::error_t{ (trace).string() + __FILE__ + ":" + __FUNCTION__             \
-        + "():" + std::to_string(__LINE__) + "\n" }
+#define RES_TRACE(trace) res::traced((trace), RES_SITE)
 
 // Append a trace to an error with an additional error message.
-#define RES_ERROR(trace, error)                                                \
-    res::error_t{ remove_last(RES_TRACE(trace).string()) + " -> " + (error)    \
-        + "\n" }
+#define RES_ERROR(trace, error) res::traced((trace), RES_SITE, (error))
 
-// Create a new error with a trace.
-#define RES_NEW_ERROR(error) RES_ERROR(res::error_t{ "" }, (error))
+// Create a new error with a trace. If stack capture is enabled (see stack.hpp),
+// the native call stack is captured as well.
+#define RES_NEW_ERROR(error) res::detail::new_error(RES_SITE, (error))
 
 // Concatenate two errors.
 #define RES_CONCAT(first_error, second_error)                                  \
@@ -64,12 +76,303 @@ std::string& remove_last(std::string& str) {
 
 namespace res {
 
+/**
+ * @brief A location in the source code. Sites without a file name are empty
+ * and are never appended to an error.
+ */
+struct site_t {
+    std::string_view file;
+    std::string_view function;
+    std::uint32_t line = 0;
+};
+
+/**
+ * @brief When and on which thread a trace was appended to an error. Recorded
+ * only while frame timing is enabled (see timeline.hpp). The site refers to
+ * the strings passed to the error macros, which must have static storage
+ * duration.
+ */
+struct timed_frame_t {
+    site_t site;
+    std::uint64_t timestamp = 0;
+    std::uint32_t thread = 0;
+};
+
+/**
+ * @brief The number of frames retained by an error (see set_trace_limit). The
+ * first frames show where the error originated and the last frames show where
+ * it was most recently propagated. Frames in between are replaced by a single
+ * "... N frames elided ..." line. Traces are unbounded if both are zero.
+ */
+struct trace_limit_t {
+    std::uint32_t first = 0;
+    std::uint32_t last = 0;
+};
+
 /**
  * @brief Represents an error message with traces.
  */
 class error_t {
     std::string error_;
 
+    // Bookkeeping for bounded traces. The limit is captured when the first
+    // frame is reserved. The first frames are appended to error_, as frames
+    // of unbounded traces are. The last frames are kept in a ring of strings
+    // that is only rendered into the message when it is read, so eliding a
+    // frame never moves the others. frames counts the frames retained in
+    // both, and elided counts those overwritten or dropped.
+    struct bound_t {
+        trace_limit_t limit;
+        std::uint32_t frames = 0;
+        std::uint64_t elided = 0;
+
+        // The last frames. Once the ring is full, oldest is the index of the
+        // frame overwritten next.
+        std::vector<std::string> last_frames;
+        std::size_t oldest = 0;
+
+        // Set while the notice or the last frames are held outside of error_.
+        bool detached = false;
+
+        // Set while the notice and the last frames are written into error_
+        // instead, starting at head_size (see string()).
+        bool flat = false;
+        std::size_t head_size = 0;
+    };
+
+    // The message rendered with the notice and the last frames for const
+    // readers. Concurrent readers render it once: the first to claim a stale
+    // rendering writes it while the others wait. Copies render again.
+    struct rendering_t {
+        static constexpr std::uint8_t stale = 0;
+        static constexpr std::uint8_t busy = 1;
+        static constexpr std::uint8_t ready = 2;
+
+        std::string text;
+        std::atomic<std::uint8_t> state{ stale };
+
+        rendering_t() = default;
+        rendering_t(const rendering_t&) {
+        }
+        rendering_t& operator=(const rendering_t&) {
+            this->state.store(stale, std::memory_order_relaxed);
+            return *this;
+        }
+    };
+
+    // Metadata that most errors never carry. It is allocated when first set,
+    // so errors without it stay the size of a string and a pointer.
+    struct extras_t {
+        // The code the error was created from, if any. Its message belongs
+        // at the beginning of the message, ahead of any traces. It is only
+        // formatted when the message is read: into the rendering for const
+        // readers, or into error_ once a mutable reference is requested.
+        int code_value = 0;
+        const std::error_category* code_category = nullptr;
+        bool code_pending = false;
+
+        // Return addresses captured when the error was created. Empty unless
+        // stack capture is enabled.
+        std::vector<std::uintptr_t> stack;
+
+        // Times at which traces were appended. Empty unless frame timing is
+        // enabled. Once a bounded timeline is full, its last entries form a
+        // ring like the last frames, and timeline_oldest is the index within
+        // them of the entry overwritten next.
+        std::vector<timed_frame_t> timeline;
+        std::size_t timeline_oldest = 0;
+
+        bound_t bound;
+        rendering_t rendering;
+    };
+
+    extras_t* extras_ = nullptr;
+
+    // Kept out of line so that copying and destroying errors without extras
+    // only inlines a null check.
+    [[gnu::noinline]] static RES_CONSTEXPR_STRING extras_t* copy_extras_(
+      const extras_t* extras) {
+        return (extras == nullptr) ? nullptr : new extras_t{ *extras };
+    }
+    [[gnu::noinline]] static RES_CONSTEXPR_STRING void delete_extras_(
+      const extras_t* extras) {
+        delete extras;
+    }
+
+    extras_t& extras_or_new_() {
+        if (this->extras_ == nullptr) {
+            this->extras_ = new extras_t{};
+        }
+        return *(this->extras_);
+    }
+
+
+    // Render the elision notice into a buffer. Returns an empty view if no
+    // frames have been elided.
+    [[nodiscard]] std::string_view notice_(char (&buffer)[64]) const {
+        const std::uint64_t elided = this->extras_->bound.elided;
+        if (elided == 0) {
+            return {};
+        }
+        constexpr std::string_view prefix = "... ";
+        const std::string_view suffix =
+          (elided == 1) ? " frame elided ...\n" : " frames elided ...\n";
+
+        prefix.copy(buffer, prefix.size());
+        char* const digits_end =
+          std::to_chars(buffer + prefix.size(), buffer + sizeof(buffer), elided)
+            .ptr;
+        suffix.copy(digits_end, suffix.size());
+        return { buffer,
+            static_cast<std::size_t>(digits_end - buffer) + suffix.size() };
+    }
+
+    // Call a function with the notice and then each of the last frames from
+    // oldest to newest, stopping early if it returns false.
+    template<typename callable_t>
+    bool for_each_detached_(const callable_t& callable) const {
+        const bound_t& bound = this->extras_->bound;
+        char buffer[64];
+        const std::string_view notice = this->notice_(buffer);
+        if (! notice.empty() && ! callable(notice)) {
+            return false;
+        }
+        const std::size_t size = bound.last_frames.size();
+        for (std::size_t index = 0; index < size; ++index) {
+            if (! callable(std::string_view{
+                  bound.last_frames[(bound.oldest + index) % size] })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void append_detached_(std::string& text) const {
+        this->for_each_detached_([&text](std::string_view part) {
+            text.append(part);
+            return true;
+        });
+    }
+
+    void append_code_(std::string& text) const {
+        const std::error_code code = this->code();
+        text.append(code.message());
+        text.append(" [");
+        text.append(code.category().name());
+        text.append(":");
+        text.append(std::to_string(code.value()));
+        text.append("]\n");
+    }
+
+    // Kept out of line, like flatten_(), so that reading a message only
+    // inlines a check for a pending code and detached frames.
+    [[gnu::noinline]] const std::string& rendered_() const {
+        rendering_t& rendering = this->extras_->rendering;
+        std::uint8_t state = rendering.state.load(std::memory_order_acquire);
+        while (state != rendering_t::ready) {
+            if (state == rendering_t::stale
+              && rendering.state.compare_exchange_weak(
+                state, rendering_t::busy, std::memory_order_acquire)) {
+                rendering.text.clear();
+                if (this->extras_->code_pending) {
+                    this->append_code_(rendering.text);
+                }
+                rendering.text.append(this->error_);
+                if (this->extras_->bound.detached) {
+                    this->append_detached_(rendering.text);
+                }
+                rendering.state.store(
+                  rendering_t::ready, std::memory_order_release);
+                break;
+            }
+            state = rendering.state.load(std::memory_order_acquire);
+        }
+        return rendering.text;
+    }
+
+    // Write the message of a pending code, the notice, and the last frames
+    // into error_ so it can be modified in place.
+    [[gnu::noinline]] void flatten_() {
+        if (this->extras_->code_pending) {
+            std::string text;
+            this->append_code_(text);
+            this->error_.insert(0, text);
+            this->extras_->code_pending = false;
+            this->extras_->rendering.state.store(
+              rendering_t::stale, std::memory_order_relaxed);
+        }
+        bound_t& bound = this->extras_->bound;
+        if (! bound.detached) {
+            return;
+        }
+        bound.head_size = this->error_.size();
+        this->append_detached_(this->error_);
+        bound.detached = false;
+        bound.flat = true;
+    }
+
+    // Undo flatten_() before the next frame is reserved. If the message was
+    // modified in the meantime, the whole message becomes the origin and
+    // frames are counted again.
+    void unflatten_() {
+        bound_t& bound = this->extras_->bound;
+        if (! bound.flat) {
+            return;
+        }
+        bound.flat = false;
+
+        const std::string_view message{ this->error_ };
+        std::size_t offset = bound.head_size;
+        const bool unmodified = offset <= message.size()
+          && this->for_each_detached_([&message, &offset](
+                                        std::string_view part) {
+                 if (message.compare(offset, part.size(), part) != 0) {
+                     return false;
+                 }
+                 offset += part.size();
+                 return true;
+             })
+          && offset == message.size();
+        if (unmodified) {
+            this->error_.resize(bound.head_size);
+            bound.detached = true;
+            return;
+        }
+        bound.frames = 0;
+        bound.elided = 0;
+        bound.last_frames.clear();
+        bound.oldest = 0;
+    }
+
+    // Kept separate from reserve_frame so that unbounded traces only inline
+    // the check for a limit.
+    std::string* reserve_bounded_frame_() {
+        bound_t& bound = this->extras_->bound;
+        this->unflatten_();
+        this->extras_->rendering.state.store(
+          rendering_t::stale, std::memory_order_relaxed);
+
+        if (bound.frames < bound.limit.first) {
+            ++bound.frames;
+            return &(this->error_);
+        }
+        bound.detached = true;
+        if (bound.frames - bound.limit.first < bound.limit.last) {
+            ++bound.frames;
+            bound.last_frames.emplace_back();
+            return &(bound.last_frames.back());
+        }
+
+        ++bound.elided;
+        if (bound.limit.last == 0) {
+            return nullptr;
+        }
+        std::string& frame = bound.last_frames[bound.oldest];
+        frame.clear();
+        bound.oldest = (bound.oldest + 1) % bound.last_frames.size();
+        return &frame;
+    }
+
   public:
     // All constructors must be explicit so construction is never ambiguous. If
     // a function returns a optional_t<std::string>, then returning a
@@ -84,28 +387,459 @@ class error_t {
     //     }
     // }
 
-    explicit error_t(const std::string& error) : error_(error) {
+    RES_CONSTEXPR_STRING explicit error_t(const std::string& error)
+    : error_(error) {
+    }
+    RES_CONSTEXPR_STRING explicit error_t(std::string&& error)
+    : error_(std::move(error)) {
+    }
+
+    // Store a system error. Its message is formatted on the first line,
+    // ahead of any traces, when the message is first read.
+    explicit error_t(std::error_code code) : extras_(new extras_t{}) {
+        this->extras_->code_value = code.value();
+        this->extras_->code_category = &(code.category());
+        this->extras_->code_pending = true;
+    }
+
+    // Copies are kept out of line, as they were before error_t declared its
+    // own copy constructor, to keep the code size of each copy small.
+    [[gnu::noinline]] RES_CONSTEXPR_STRING error_t(const error_t& error)
+    : error_(error.error_), extras_(copy_extras_(error.extras_)) {
+    }
+
+    RES_CONSTEXPR_STRING error_t(error_t&& error) noexcept
+    : error_(std::move(error.error_)), extras_(error.extras_) {
+        error.extras_ = nullptr;
     }
-    explicit error_t(std::string&& error) : error_(std::move(error)) {
+
+    RES_CONSTEXPR_STRING error_t& operator=(const error_t& error) {
+        if (this != &error) {
+            error_t copy{ error };
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    RES_CONSTEXPR_STRING error_t& operator=(error_t&& error) noexcept {
+        if (this != &error) {
+            this->error_ = std::move(error.error_);
+            if (this->extras_ != nullptr) {
+                delete_extras_(this->extras_);
+            }
+            this->extras_ = error.extras_;
+            error.extras_ = nullptr;
+        }
+        return *this;
+    }
+
+    RES_CONSTEXPR_STRING ~error_t() {
+        if (this->extras_ != nullptr) {
+            delete_extras_(this->extras_);
+        }
     }
 
     /**
-     * @brief Get a const reference to the stored error message.
+     * @brief Get a const reference to the stored error message. The message of
+     * an error whose trace is bounded is rendered with its elided and last
+     * frames when first read after a change. The reference remains valid
+     * until the error is next modified.
      */
-    [[nodiscard]] const std::string& string() const {
+    [[nodiscard]] RES_CONSTEXPR_STRING const std::string& string() const {
+        if (this->extras_ != nullptr
+          && (this->extras_->bound.detached || this->extras_->code_pending)) {
+            return this->rendered_();
+        }
         return this->error_;
     }
 
     /**
-     * @brief Get a mutable reference to the stored error message.
+     * @brief Get a mutable reference to the stored error message. If the
+     * message of an error whose trace is bounded is changed through it, the
+     * whole message becomes the origin of the trace (see set_trace_limit).
      */
-    [[nodiscard]] std::string& string() {
+    [[nodiscard]] RES_CONSTEXPR_STRING std::string& string() {
+        if (this->extras_ != nullptr
+          && (this->extras_->bound.detached || this->extras_->code_pending)) {
+            this->flatten_();
+        }
         return this->error_;
     }
+
+    /**
+     * @brief Append text to the error message.
+     */
+    RES_CONSTEXPR_STRING error_t& append(std::string_view text) {
+        this->string().append(text);
+        return *this;
+    }
+
+    /**
+     * @return true if this error was created from a std::error_code and false
+     * otherwise.
+     */
+    [[nodiscard]] constexpr bool has_code() const {
+        return this->extras_ != nullptr
+          && this->extras_->code_category != nullptr;
+    }
+
+    /**
+     * @return the std::error_code this error was created from or a
+     * default-constructed code if it was not created from one.
+     */
+    [[nodiscard]] std::error_code code() const {
+        if (! this->has_code()) {
+            return std::error_code{};
+        }
+        return std::error_code{ this->extras_->code_value,
+            *(this->extras_->code_category) };
+    }
+
+    /**
+     * @brief Get the raw return addresses captured when this error was created.
+     * The addresses are not symbolized (see res::render_stack in stack.hpp).
+     */
+    [[nodiscard]] const std::vector<std::uintptr_t>& stack() const {
+        static const std::vector<std::uintptr_t> empty;
+        return (this->extras_ == nullptr) ? empty : this->extras_->stack;
+    }
+
+    /**
+     * @brief Replace the captured return addresses.
+     */
+    void set_stack(std::vector<std::uintptr_t> stack) {
+        this->extras_or_new_().stack = std::move(stack);
+    }
+
+    /**
+     * @brief Get the times at which traces were appended to this error, from
+     * oldest to newest (see timeline.hpp).
+     */
+    [[nodiscard]] std::vector<timed_frame_t> timeline() const {
+        if (this->extras_ == nullptr) {
+            return {};
+        }
+        std::vector<timed_frame_t> timeline = this->extras_->timeline;
+        if (this->extras_->timeline_oldest != 0) {
+            const auto last = timeline.end()
+              - static_cast<std::ptrdiff_t>(this->extras_->bound.limit.last);
+            std::rotate(last,
+              last
+                + static_cast<std::ptrdiff_t>(this->extras_->timeline_oldest),
+              timeline.end());
+        }
+        return timeline;
+    }
+
+    /**
+     * @brief Record the time at which a trace was appended. The timeline is
+     * bounded by the same limit as the trace.
+     */
+    void add_timed_frame(const timed_frame_t& frame) {
+        extras_t& extras = this->extras_or_new_();
+        std::vector<timed_frame_t>& timeline = extras.timeline;
+        if (this->bounded()) {
+            const trace_limit_t limit = extras.bound.limit;
+            const std::size_t capacity =
+              std::size_t{ limit.first } + limit.last;
+            if (timeline.size() >= capacity) {
+                if (limit.last == 0) {
+                    return;
+                }
+                // Overwrite the oldest of the last entries.
+                timeline[(timeline.size() - limit.last)
+                  + extras.timeline_oldest] = frame;
+                extras.timeline_oldest =
+                  (extras.timeline_oldest + 1) % limit.last;
+                return;
+            }
+        }
+        timeline.push_back(frame);
+    }
+
+    /**
+     * @brief Make room for one more frame within a trace limit. Once the last
+     * frames are full, the oldest of them is elided and its storage is reused
+     * for the new frame. The limit is captured by the first call that
+     * reserves a frame and is used for the lifetime of this error.
+     *
+     * @return the string to which the frame must be appended or null if the
+     * frame must not be appended because no last frames are retained.
+     */
+    std::string* reserve_frame(trace_limit_t limit) {
+        if (this->extras_ == nullptr
+          || (this->extras_->bound.frames == 0
+            && this->extras_->bound.elided == 0)) {
+            if (this->extras_ == nullptr && limit.first == 0
+              && limit.last == 0) {
+                return &(this->error_);
+            }
+            this->extras_or_new_().bound.limit = limit;
+        }
+        if (! this->bounded()) {
+            // The rendering of a pending code includes the new frame.
+            this->extras_->rendering.state.store(
+              rendering_t::stale, std::memory_order_relaxed);
+            return &(this->error_);
+        }
+        return this->reserve_bounded_frame_();
+    }
+
+    /**
+     * @return true if the trace of this error is bounded by a trace limit and
+     * false otherwise.
+     */
+    [[nodiscard]] RES_CONSTEXPR_STRING bool bounded() const {
+        return this->extras_ != nullptr
+          && (this->extras_->bound.limit.first != 0
+            || this->extras_->bound.limit.last != 0);
+    }
+
+    /**
+     * @return the number of frames elided from this error by its trace limit.
+     */
+    [[nodiscard]] RES_CONSTEXPR_STRING std::uint64_t elided_frames() const {
+        return (this->extras_ == nullptr) ? 0 : this->extras_->bound.elided;
+    }
 };
 
 inline std::ostream& operator<<(std::ostream& ostream, const error_t& error) {
     return (ostream << error.string());
 }
 
+namespace detail {
+
+/**
+ * @brief Records the time at which a trace is appended to an error. Frame
+ * timing is disabled while this is null.
+ */
+using frame_timer_t = void (*)(error_t& error, const site_t& site);
+
+inline std::atomic<frame_timer_t> frame_timer{ nullptr };
+
+// The current trace limit with the first frame count in the upper 32 bits.
+inline std::atomic<std::uint64_t> packed_trace_limit{ 0 };
+
+inline void time_frame(error_t& error, const site_t& site) {
+    const frame_timer_t timer = frame_timer.load(std::memory_order_relaxed);
+    if (timer != nullptr) {
+        timer(error, site);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Bound the number of frames retained by errors. Deep recursion and
+ * retry loops otherwise grow an error by one line per frame without bound.
+ * Unbounded by default.
+ *
+ * An error captures the limit that is current when it receives its first
+ * trace while a limit is set, and keeps it from then on. This includes errors
+ * that received unbounded traces before this call: the message they already
+ * hold becomes the origin of their trace, and their later frames are bounded.
+ * Errors that are already bounded are unaffected.
+ */
+inline void set_trace_limit(trace_limit_t limit) {
+    detail::packed_trace_limit.store(
+      (std::uint64_t{ limit.first } << 32U) | limit.last,
+      std::memory_order_relaxed);
+}
+
+/**
+ * @return the current trace limit.
+ */
+[[nodiscard]] inline trace_limit_t trace_limit() {
+    const std::uint64_t packed =
+      detail::packed_trace_limit.load(std::memory_order_relaxed);
+    return trace_limit_t{ static_cast<std::uint32_t>(packed >> 32U),
+        static_cast<std::uint32_t>(packed) };
+}
+
+namespace detail {
+
+/**
+ * @brief Make room for one more frame within the current trace limit. Only a
+ * single load and comparison are inlined while traces are unbounded.
+ *
+ * @return the string to which the frame must be appended or null if the frame
+ * must not be appended.
+ */
+inline std::string* reserve_frame(error_t& error) {
+    if (packed_trace_limit.load(std::memory_order_relaxed) == 0
+      && ! error.bounded()) {
+        return error.reserve_frame(trace_limit_t{});
+    }
+    return error.reserve_frame(trace_limit());
+}
+
+} // namespace detail
+
+/**
+ * @brief Append a trace for a site to an error in place.
+ */
+inline error_t& append_trace(error_t& error, const site_t& site) {
+    std::string* const frame = detail::reserve_frame(error);
+    if (frame == nullptr) {
+        return error;
+    }
+    frame->append(site.file);
+    frame->append(":");
+    frame->append(site.function);
+    frame->append("():");
+    frame->append(std::to_string(site.line));
+    frame->append("\n");
+    detail::time_frame(error, site);
+    return error;
+}
+
+/**
+ * @brief Append a trace for a site with an additional error message to an
+ * error in place.
+ */
+inline error_t& append_trace(
+  error_t& error, const site_t& site, std::string_view message) {
+    std::string* const frame = detail::reserve_frame(error);
+    if (frame == nullptr) {
+        return error;
+    }
+    frame->append(site.file);
+    frame->append(":");
+    frame->append(site.function);
+    frame->append("():");
+    frame->append(std::to_string(site.line));
+    frame->append(" -> ");
+    frame->append(message);
+    frame->append("\n");
+    detail::time_frame(error, site);
+    return error;
+}
+
+/**
+ * @return a copy of an error with a trace for a site appended.
+ */
+[[nodiscard]] inline error_t traced(
+  const error_t& error, const site_t& site) {
+    RES_FIRE_PROBE(trace, site, std::string_view{});
+    error_t copy{ error };
+    return std::move(append_trace(copy, site));
+}
+
+/**
+ * @return an error with a trace for a site appended. The error is moved
+ * rather than copied.
+ */
+[[nodiscard]] inline error_t traced(error_t&& error, const site_t& site) {
+    RES_FIRE_PROBE(trace, site, std::string_view{});
+    return std::move(append_trace(error, site));
+}
+
+/**
+ * @return a copy of an error with a trace for a site and an additional error
+ * message appended.
+ */
+[[nodiscard]] inline error_t traced(
+  const error_t& error, const site_t& site, std::string_view message) {
+    RES_FIRE_PROBE(error, site, message);
+    error_t copy{ error };
+    return std::move(append_trace(copy, site, message));
+}
+
+/**
+ * @return an error with a trace for a site and an additional error message
+ * appended. The error is moved rather than copied.
+ */
+[[nodiscard]] inline error_t traced(
+  error_t&& error, const site_t& site, std::string_view message) {
+    RES_FIRE_PROBE(error, site, message);
+    return std::move(append_trace(error, site, message));
+}
+
+namespace detail {
+
+/**
+ * @brief Captures the native call stack into a new error. Stack capture is
+ * disabled while this is null.
+ */
+using stack_capture_t = void (*)(error_t& error);
+
+inline std::atomic<stack_capture_t> stack_capture{ nullptr };
+
+/**
+ * @return a new error with a trace for a site and an error message. The native
+ * call stack is attached if stack capture is enabled.
+ */
+[[nodiscard]] inline error_t new_error(
+  const site_t& site, std::string_view message) {
+    RES_FIRE_PROBE(new_error, site, message);
+    error_t error{ std::string{} };
+    const stack_capture_t capture =
+      stack_capture.load(std::memory_order_relaxed);
+    if (capture != nullptr) {
+        capture(error);
+    }
+    return std::move(append_trace(error, site, message));
+}
+
+// Passed to the private constructors of optional_t and result_t that take
+// ownership of an already allocated error.
+struct error_ptr_tag_t {};
+
+// Passed to the private constructors of optional_t and result_t that publish
+// the address of the object under construction (see coroutine.hpp).
+struct slot_tag_t {};
+
+/**
+ * @brief True for types that store their error in a std::unique_ptr and can
+ * take ownership of one without allocating.
+ */
+template<typename type_t>
+struct is_error_owner : std::false_type {};
+
+template<typename type_t>
+constexpr inline bool is_error_owner_v = is_error_owner<type_t>::value;
+
+/**
+ * @brief Grants the combinators of optional_t and result_t access to each
+ * other's errors.
+ */
+struct access_t {
+    template<typename owner_t>
+    [[nodiscard]] static owner_t from_error(std::unique_ptr<error_t>&& error) {
+        return owner_t{ error_ptr_tag_t{}, std::move(error) };
+    }
+
+    template<typename owner_t>
+    [[nodiscard]] static std::unique_ptr<error_t> take_error(owner_t& owner) {
+        return owner.take_error_();
+    }
+
+    // The returned object is constructed directly in its final location, so
+    // the address stored in the slot remains valid.
+    template<typename owner_t>
+    [[nodiscard]] static owner_t link(owner_t** slot) {
+        return owner_t{ slot_tag_t{}, slot };
+    }
+};
+
+/**
+ * @brief Construct the type returned by a combinator from the error being
+ * propagated, appending a trace for the combinator site if one was given.
+ */
+template<typename returned_t>
+[[nodiscard]] returned_t propagate(
+  std::unique_ptr<error_t>&& error, const site_t& site) {
+    if (! site.file.empty()) {
+        append_trace(*error, site);
+    }
+
+    if constexpr (is_error_owner_v<returned_t>) {
+        return access_t::from_error<returned_t>(std::move(error));
+    } else {
+        return returned_t{ std::move(*error) };
+    }
+}
+
+} // namespace detail
+
 } // namespace res
@@ -0,0 +1,354 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file executor.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief A small work-stealing thread pool that produces future_t results.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Local includes
+#include "error.hpp"
+#include "future.hpp"
+#include "optional.hpp"
+
+namespace res {
+
+class executor_t;
+
+namespace detail {
+
+/**
+ * @brief A move-only type-erased function with no parameters.
+ */
+class task_t {
+    struct base_t {
+        base_t() = default;
+        base_t(const base_t&) = delete;
+        base_t(base_t&&) = delete;
+        base_t& operator=(const base_t&) = delete;
+        base_t& operator=(base_t&&) = delete;
+        virtual ~base_t() = default;
+
+        virtual void run() = 0;
+    };
+
+    template<typename callable_t>
+    struct impl_t final : base_t {
+        callable_t callable;
+
+        explicit impl_t(callable_t&& callable)
+        : callable(std::move(callable)) {
+        }
+
+        void run() override {
+            this->callable();
+        }
+    };
+
+    std::unique_ptr<base_t> callable_;
+
+  public:
+    task_t() = default;
+
+    template<typename callable_t>
+    explicit task_t(callable_t&& callable)
+    : callable_(std::make_unique<impl_t<std::decay_t<callable_t>>>(
+        std::forward<callable_t>(callable))) {
+    }
+
+    void operator()() {
+        this->callable_->run();
+    }
+};
+
+template<typename returned_t>
+struct optional_value {};
+
+template<typename type_t>
+struct optional_value<optional_t<type_t>> {
+    using type = type_t;
+};
+
+template<typename returned_t>
+using optional_value_t = typename optional_value<returned_t>::type;
+
+inline const std::string task_exception_message{
+    "The task threw an exception"
+};
+
+/**
+ * @brief Call a function returning an optional_t on a worker thread. An
+ * exception thrown by the function is returned as an error instead of
+ * terminating the worker.
+ */
+template<typename callable_t>
+[[nodiscard]] std::invoke_result_t<callable_t&> invoke_task(
+  callable_t& callable) {
+    try {
+        return callable();
+    } catch (const std::exception& exception) {
+        return RES_NEW_ERROR(
+          task_exception_message + ": " + exception.what());
+    } catch (...) {
+        return RES_NEW_ERROR(task_exception_message + ".");
+    }
+}
+
+/**
+ * @brief The executor and worker index of the current thread, if it is a
+ * worker thread.
+ */
+struct worker_identity_t {
+    const executor_t* executor = nullptr;
+    std::size_t index = 0;
+};
+
+inline worker_identity_t& worker_identity() {
+    thread_local worker_identity_t identity;
+    return identity;
+}
+
+} // namespace detail
+
+/**
+ * @brief A fixed-size thread pool in which each worker owns a task queue.
+ * Workers run their own tasks newest first and steal the oldest tasks from
+ * other workers when their own queue is empty. Tasks submitted from a worker
+ * are queued on that worker, so related tasks tend to stay on one thread.
+ *
+ * NOTE: Tasks should not block on futures produced by the same executor, as
+ * every worker could end up waiting. Use when_all or when_any instead.
+ */
+class executor_t {
+    struct queue_t {
+        std::mutex mutex;
+        std::deque<detail::task_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<queue_t>> queues_;
+    std::vector<std::thread> workers_;
+
+    // Tasks that are queued but not yet taken by a worker.
+    std::atomic<std::size_t> pending_{ 0 };
+    std::atomic<std::size_t> sleeping_{ 0 };
+    std::atomic<std::size_t> next_queue_{ 0 };
+    std::atomic<bool> stopping_{ false };
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+
+    static inline const std::string cancelled_message{
+        "The task was cancelled before it started."
+    };
+
+    [[nodiscard]] bool pop_(std::size_t index, detail::task_t& task) {
+        {
+            queue_t& own = *(this->queues_[index]);
+            const std::lock_guard<std::mutex> lock{ own.mutex };
+            if (! own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+
+        for (std::size_t offset = 1; offset < this->queues_.size(); ++offset) {
+            queue_t& victim =
+              *(this->queues_[(index + offset) % this->queues_.size()]);
+            const std::lock_guard<std::mutex> lock{ victim.mutex };
+            if (! victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void work_(std::size_t index) {
+        detail::worker_identity() = { this, index };
+
+        detail::task_t task;
+        while (true) {
+            if (this->pop_(index, task)) {
+                this->pending_.fetch_sub(1);
+                task();
+                task = detail::task_t{};
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{ this->sleep_mutex_ };
+            if (this->stopping_.load() && this->pending_.load() == 0) {
+                return;
+            }
+
+            // Paired with the check of sleeping_ in submit_() so that either
+            // this worker sees the new task or the submitter sees this worker.
+            this->sleeping_.fetch_add(1);
+            this->wake_.wait(lock, [this] {
+                return this->pending_.load() > 0 || this->stopping_.load();
+            });
+            this->sleeping_.fetch_sub(1);
+        }
+    }
+
+    void submit_(detail::task_t&& task) {
+        const detail::worker_identity_t& identity = detail::worker_identity();
+        const std::size_t index = (identity.executor == this)
+          ? identity.index
+          : this->next_queue_.fetch_add(1, std::memory_order_relaxed)
+            % this->queues_.size();
+
+        this->pending_.fetch_add(1);
+        {
+            queue_t& queue = *(this->queues_[index]);
+            const std::lock_guard<std::mutex> lock{ queue.mutex };
+            queue.tasks.push_back(std::move(task));
+        }
+
+        if (this->sleeping_.load() > 0) {
+            const std::lock_guard<std::mutex> lock{ this->sleep_mutex_ };
+            this->wake_.notify_one();
+        }
+    }
+
+  public:
+    /**
+     * @param thread_count - The number of worker threads. Defaults to the
+     * number of hardware threads.
+     */
+    explicit executor_t(std::size_t thread_count = 0) {
+        if (thread_count == 0) {
+            thread_count =
+              std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        this->queues_.reserve(thread_count);
+        for (std::size_t index = 0; index < thread_count; ++index) {
+            this->queues_.push_back(std::make_unique<queue_t>());
+        }
+
+        this->workers_.reserve(thread_count);
+        for (std::size_t index = 0; index < thread_count; ++index) {
+            this->workers_.emplace_back([this, index] { this->work_(index); });
+        }
+    }
+
+    executor_t(const executor_t&) = delete;
+    executor_t(executor_t&&) = delete;
+    executor_t& operator=(const executor_t&) = delete;
+    executor_t& operator=(executor_t&&) = delete;
+
+    /**
+     * @brief Finish all queued tasks and join the worker threads.
+     */
+    ~executor_t() {
+        {
+            const std::lock_guard<std::mutex> lock{ this->sleep_mutex_ };
+            this->stopping_.store(true);
+        }
+        this->wake_.notify_all();
+
+        for (std::thread& worker : this->workers_) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @return the number of worker threads.
+     */
+    [[nodiscard]] std::size_t size() const {
+        return this->workers_.size();
+    }
+
+    /**
+     * @brief Run a function on a worker thread.
+     *
+     * @param token - If cancelled before the function starts, the function is
+     * skipped and the future contains an error instead. Functions that run for
+     * a long time may also check the token themselves.
+     * @param callable - A function returning an optional_t.
+     * @return a future containing the optional_t returned by the function, or
+     * an error if the function threw an exception.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto async(
+      const cancellation_token_t& token, callable_t&& callable) {
+        using value_t =
+          detail::optional_value_t<std::invoke_result_t<callable_t&>>;
+
+        auto [promise, future] = make_promise<value_t>();
+        this->submit_(detail::task_t{
+          [token,
+            promise = std::move(promise),
+            callable = std::forward<callable_t>(callable)]() mutable {
+              if (token.cancelled()) {
+                  (void)promise.set(RES_NEW_ERROR(cancelled_message));
+                  return;
+              }
+              (void)promise.set(detail::invoke_task(callable));
+          } });
+        return std::move(future);
+    }
+
+    /**
+     * @brief Run a function on a worker thread.
+     *
+     * @param callable - A function returning an optional_t.
+     * @return a future containing the optional_t returned by the function, or
+     * an error if the function threw an exception.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto async(callable_t&& callable) {
+        using value_t =
+          detail::optional_value_t<std::invoke_result_t<callable_t&>>;
+
+        auto [promise, future] = make_promise<value_t>();
+        this->submit_(detail::task_t{
+          [promise = std::move(promise),
+            callable = std::forward<callable_t>(callable)]() mutable {
+              (void)promise.set(detail::invoke_task(callable));
+          } });
+        return std::move(future);
+    }
+};
+
+} // namespace res
@@ -0,0 +1,480 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file future.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief Futures carrying optional_t results, with when_all and when_any.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Local includes
+#include "error.hpp"
+#include "optional.hpp"
+#include "result.hpp"
+
+namespace res {
+
+/**
+ * @brief A shared flag used to ask outstanding work to stop. Copies refer to
+ * the same flag.
+ */
+class cancellation_token_t {
+    std::shared_ptr<std::atomic<bool>> cancelled_ =
+      std::make_shared<std::atomic<bool>>(false);
+
+  public:
+    /**
+     * @brief Request cancellation of all work observing this token.
+     */
+    void cancel() const {
+        this->cancelled_->store(true, std::memory_order_release);
+    }
+
+    /**
+     * @return true if cancellation was requested and false otherwise.
+     */
+    [[nodiscard]] bool cancelled() const {
+        return this->cancelled_->load(std::memory_order_acquire);
+    }
+};
+
+namespace detail {
+
+inline const std::string no_futures_message{
+    "when_any requires at least one future."
+};
+
+inline const std::string invalid_future_message{
+    "Attempted to combine a future_t without a shared state."
+};
+
+} // namespace detail
+
+template<typename type_t>
+class future_t;
+
+template<typename type_t>
+class promise_t;
+
+namespace detail {
+
+/**
+ * @brief The state shared between a promise_t and its future_t. Setting and
+ * polling the result are lock-free. The mutex is only used to put a thread
+ * blocked in wait() to sleep.
+ */
+template<typename type_t>
+class future_state_t {
+    static constexpr std::uint32_t ready_flag = 1;
+    static constexpr std::uint32_t continued_flag = 2;
+    static constexpr std::uint32_t waiting_flag = 4;
+
+    // Number of times wait() polls before sleeping.
+    static constexpr int spin_count = 64;
+
+    std::atomic<std::uint32_t> flags_{ 0 };
+    std::optional<optional_t<type_t>> result_;
+    std::function<void(optional_t<type_t>&&)> continuation_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+
+  public:
+    [[nodiscard]] bool ready() const {
+        return (this->flags_.load(std::memory_order_acquire) & ready_flag) != 0;
+    }
+
+    void set(optional_t<type_t>&& result) {
+        this->result_.emplace(std::move(result));
+        const std::uint32_t flags =
+          this->flags_.fetch_or(ready_flag, std::memory_order_acq_rel);
+
+        if ((flags & waiting_flag) != 0) {
+            const std::lock_guard<std::mutex> lock{ this->mutex_ };
+            this->condition_.notify_all();
+        }
+        if ((flags & continued_flag) != 0) {
+            std::exchange(this->continuation_, nullptr)(this->take());
+        }
+    }
+
+    void wait() {
+        for (int spin = 0; spin < spin_count; ++spin) {
+            if (this->ready()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock{ this->mutex_ };
+        const std::uint32_t flags =
+          this->flags_.fetch_or(waiting_flag, std::memory_order_acq_rel);
+        if ((flags & ready_flag) != 0) {
+            return;
+        }
+        this->condition_.wait(lock, [this] { return this->ready(); });
+    }
+
+    [[nodiscard]] optional_t<type_t> take() {
+        optional_t<type_t> result = std::move(*(this->result_));
+        this->result_.reset();
+        return result;
+    }
+
+    /**
+     * @brief Call a function with the result once it is set. Only one
+     * continuation may be attached, and the result may not be taken by
+     * anything else.
+     */
+    template<typename callable_t>
+    void on_ready(callable_t&& callable) {
+        this->continuation_ = std::forward<callable_t>(callable);
+        const std::uint32_t flags =
+          this->flags_.fetch_or(continued_flag, std::memory_order_acq_rel);
+        if ((flags & ready_flag) != 0) {
+            std::exchange(this->continuation_, nullptr)(this->take());
+        }
+    }
+};
+
+struct future_access_t {
+    template<typename owner_t, typename type_t>
+    [[nodiscard]] static owner_t from_state(
+      std::shared_ptr<future_state_t<type_t>> state) {
+        return owner_t{ std::move(state) };
+    }
+
+    template<typename type_t>
+    [[nodiscard]] static std::shared_ptr<future_state_t<type_t>> take_state(
+      future_t<type_t>& future) {
+        return std::move(future.state_);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief The receiving end of an asynchronous optional_t.
+ */
+template<typename type_t>
+class future_t {
+    std::shared_ptr<detail::future_state_t<type_t>> state_;
+
+    static inline const std::string no_state_message{
+        "Attempted to get the result of a future_t without a shared state."
+    };
+
+    friend struct detail::future_access_t;
+
+    explicit future_t(std::shared_ptr<detail::future_state_t<type_t>> state)
+    : state_(std::move(state)) {
+    }
+
+  public:
+    future_t() = default;
+
+    // The result can only be taken once, so futures are move-only.
+    future_t(const future_t&) = delete;
+    future_t(future_t&&) noexcept = default;
+    future_t& operator=(const future_t&) = delete;
+    future_t& operator=(future_t&&) noexcept = default;
+    ~future_t() = default;
+
+    /**
+     * @return true if this future refers to a shared state and false if it is
+     * default constructed, moved from, or its result was already taken.
+     */
+    [[nodiscard]] bool valid() const {
+        return this->state_ != nullptr;
+    }
+
+    /**
+     * @return true if the result is available and false otherwise.
+     */
+    [[nodiscard]] bool ready() const {
+        return this->valid() && this->state_->ready();
+    }
+
+    /**
+     * @brief Block until the result is available.
+     */
+    void wait() const {
+        if (this->valid()) {
+            this->state_->wait();
+        }
+    }
+
+    /**
+     * @brief Block until the result is available and take it. The future is
+     * invalid afterward.
+     *
+     * @return the result or an error if this future is invalid.
+     */
+    [[nodiscard]] optional_t<type_t> get() {
+        if (! this->valid()) {
+            return RES_NEW_ERROR(no_state_message);
+        }
+
+        this->state_->wait();
+        optional_t<type_t> result = this->state_->take();
+        this->state_.reset();
+        return result;
+    }
+};
+
+/**
+ * @brief The sending end of an asynchronous optional_t. Destroying a promise
+ * without setting its result sets an error instead.
+ */
+template<typename type_t>
+class promise_t {
+    std::shared_ptr<detail::future_state_t<type_t>> state_;
+
+    static inline const std::string no_state_message{
+        "Attempted to set the result of a promise_t without a shared state."
+    };
+    static inline const std::string broken_promise_message{
+        "The promise_t was destroyed without setting a result."
+    };
+
+    friend struct detail::future_access_t;
+
+    explicit promise_t(std::shared_ptr<detail::future_state_t<type_t>> state)
+    : state_(std::move(state)) {
+    }
+
+  public:
+    promise_t() = default;
+    promise_t(const promise_t&) = delete;
+    promise_t(promise_t&&) noexcept = default;
+    promise_t& operator=(const promise_t&) = delete;
+    promise_t& operator=(promise_t&& promise) noexcept {
+        if (this != &promise) {
+            this->abandon_();
+            this->state_ = std::move(promise.state_);
+        }
+        return *this;
+    }
+    ~promise_t() {
+        this->abandon_();
+    }
+
+    /**
+     * @return true if the result has not been set yet and false otherwise.
+     */
+    [[nodiscard]] bool valid() const {
+        return this->state_ != nullptr;
+    }
+
+    /**
+     * @brief Set the result and wake or continue the receiving future. The
+     * promise is invalid afterward.
+     *
+     * @return an error if the result was already set.
+     */
+    [[nodiscard]] result_t set(optional_t<type_t> result) {
+        if (! this->valid()) {
+            return RES_NEW_ERROR(no_state_message);
+        }
+
+        std::exchange(this->state_, nullptr)->set(std::move(result));
+        return res::success;
+    }
+
+  private:
+    void abandon_() {
+        if (this->valid()) {
+            (void)this->set(RES_NEW_ERROR(broken_promise_message));
+        }
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Call a function with the result of a future once it is set. The
+ * future is invalid afterward. An invalid future produces an error
+ * immediately.
+ */
+template<typename type_t, typename callable_t>
+void on_ready(future_t<type_t>&& future, callable_t&& callable) {
+    std::shared_ptr<future_state_t<type_t>> state =
+      future_access_t::take_state(future);
+    if (state == nullptr) {
+        callable(optional_t<type_t>{ RES_NEW_ERROR(invalid_future_message) });
+        return;
+    }
+    state->on_ready(std::forward<callable_t>(callable));
+}
+
+} // namespace detail
+
+/**
+ * @brief Create a connected promise and future.
+ */
+template<typename type_t>
+[[nodiscard]] std::pair<promise_t<type_t>, future_t<type_t>> make_promise() {
+    using access_t = detail::future_access_t;
+
+    auto state = std::make_shared<detail::future_state_t<type_t>>();
+    auto future = access_t::from_state<future_t<type_t>>(state);
+    return { access_t::from_state<promise_t<type_t>>(std::move(state)),
+        std::move(future) };
+}
+
+/**
+ * @brief Create a future that already contains a result.
+ */
+template<typename type_t>
+[[nodiscard]] future_t<type_t> make_ready_future(optional_t<type_t> result) {
+    auto [promise, future] = make_promise<type_t>();
+    (void)promise.set(std::move(result));
+    return std::move(future);
+}
+
+/**
+ * @brief Combine futures into one that contains all of their values in order.
+ * The combined future fails as soon as any future fails, without waiting for
+ * the rest, and the token is cancelled so that outstanding work can stop
+ * early. The given futures are invalid afterward.
+ */
+template<typename type_t>
+[[nodiscard]] future_t<std::vector<type_t>> when_all(
+  std::vector<future_t<type_t>>&& futures, cancellation_token_t token = {}) {
+    using returned_t = optional_t<std::vector<type_t>>;
+
+    struct state_t {
+        std::vector<std::optional<type_t>> values;
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> done{ false };
+        promise_t<std::vector<type_t>> promise;
+        cancellation_token_t token;
+    };
+
+    auto [promise, future] = make_promise<std::vector<type_t>>();
+    if (futures.empty()) {
+        (void)promise.set(std::vector<type_t>{});
+        return std::move(future);
+    }
+
+    auto state = std::make_shared<state_t>();
+    state->values.resize(futures.size());
+    state->remaining.store(futures.size(), std::memory_order_relaxed);
+    state->promise = std::move(promise);
+    state->token = std::move(token);
+
+    for (std::size_t index = 0; index < futures.size(); ++index) {
+        detail::on_ready(std::move(futures[index]),
+          [state, index](optional_t<type_t>&& result) {
+              if (result.has_error()) {
+                  if (! state->done.exchange(true)) {
+                      state->token.cancel();
+                      (void)state->promise.set(detail::propagate<returned_t>(
+                        detail::access_t::take_error(result), RES_SITE));
+                  }
+                  return;
+              }
+
+              state->values[index].emplace(std::move(result.value()));
+              if (state->remaining.fetch_sub(1, std::memory_order_acq_rel)
+                  == 1
+                && ! state->done.exchange(true)) {
+                  std::vector<type_t> values;
+                  values.reserve(state->values.size());
+                  for (std::optional<type_t>& value : state->values) {
+                      values.push_back(std::move(*value));
+                  }
+                  (void)state->promise.set(std::move(values));
+              }
+          });
+    }
+
+    return std::move(future);
+}
+
+/**
+ * @brief Combine futures into one that contains the index and value of the
+ * first future to succeed. The token is cancelled once a value is found. The
+ * combined future fails only if every future fails, in which case it contains
+ * the error of the last one. The given futures are invalid afterward.
+ */
+template<typename type_t>
+[[nodiscard]] future_t<std::pair<std::size_t, type_t>> when_any(
+  std::vector<future_t<type_t>>&& futures, cancellation_token_t token = {}) {
+    using value_t = std::pair<std::size_t, type_t>;
+    using returned_t = optional_t<value_t>;
+
+    struct state_t {
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> done{ false };
+        promise_t<value_t> promise;
+        cancellation_token_t token;
+    };
+
+    auto [promise, future] = make_promise<value_t>();
+    if (futures.empty()) {
+        (void)promise.set(RES_NEW_ERROR(detail::no_futures_message));
+        return std::move(future);
+    }
+
+    auto state = std::make_shared<state_t>();
+    state->remaining.store(futures.size(), std::memory_order_relaxed);
+    state->promise = std::move(promise);
+    state->token = std::move(token);
+
+    for (std::size_t index = 0; index < futures.size(); ++index) {
+        detail::on_ready(std::move(futures[index]),
+          [state, index](optional_t<type_t>&& result) {
+              const bool last =
+                state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1;
+
+              if (result.has_value()) {
+                  if (! state->done.exchange(true)) {
+                      state->token.cancel();
+                      (void)state->promise.set(
+                        value_t{ index, std::move(result.value()) });
+                  }
+              } else if (last && ! state->done.exchange(true)) {
+                  (void)state->promise.set(detail::propagate<returned_t>(
+                    detail::access_t::take_error(result), RES_SITE));
+              }
+          });
+    }
+
+    return std::move(future);
+}
+
+} // namespace res
@@ -0,0 +1,494 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file journal.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief A memory-mapped journal of recent errors that survives crashes.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// POSIX includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Local includes
+#include "error.hpp"
+#include "optional.hpp"
+#include "result.hpp"
+#include "serialize.hpp"
+
+// Journal file layout (all integers are native-endian):
+//
+//   header (64 bytes):
+//     u8[4] magic              "RESJ"
+//     u32   version            journal_version
+//     u32   slot_count
+//     u32   records_per_slot
+//     u32   record_size        a multiple of 64 bytes
+//   slots (slot_count times):
+//     u64   next_sequence      padded to 64 bytes
+//     records (records_per_slot * record_size bytes):
+//       u64   sequence         zero while the record is empty or being written
+//       i64   timestamp        nanoseconds since the UNIX epoch
+//       u32   size             the size of the encoded error
+//       u32   reserved
+//       u8[]  encoded error    see serialize.hpp
+//
+// Each thread appends to its own slot, so concurrent writers never contend
+// for the same cache lines. Records within a slot are reused in a circle, so
+// each slot retains its most recent records_per_slot errors.
+
+namespace res {
+
+constexpr inline std::uint32_t journal_version = 1;
+
+namespace detail {
+
+constexpr inline char journal_magic[4] = { 'R', 'E', 'S', 'J' };
+constexpr inline std::size_t journal_header_size = 64;
+constexpr inline std::size_t journal_slot_header_size = 64;
+constexpr inline std::size_t journal_record_header_size = 24;
+constexpr inline std::size_t journal_alignment = 64;
+
+struct journal_header_t {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t slot_count;
+    std::uint32_t records_per_slot;
+    std::uint32_t record_size;
+};
+
+static_assert(sizeof(journal_header_t) <= journal_header_size);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+  "The journal requires lock-free 64-bit atomics in shared memory.");
+
+/**
+ * @brief View an aligned 64-bit word within the mapping as an atomic.
+ */
+inline std::atomic<std::uint64_t>& journal_word(unsigned char* address) {
+    return *reinterpret_cast<std::atomic<std::uint64_t>*>(address);
+}
+
+inline std::uint64_t journal_load(const unsigned char* address) {
+    return journal_word(const_cast<unsigned char*>(address))
+      .load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Assigns a distinct index to each thread the first time it appends.
+ */
+inline std::size_t journal_thread_index() {
+    static std::atomic<std::size_t> next_index{ 0 };
+    thread_local const std::size_t index =
+      next_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+[[nodiscard]] inline std::string errno_message() {
+    return std::strerror(errno);
+}
+
+} // namespace detail
+
+/**
+ * @brief An error recovered from a journal.
+ */
+struct journal_entry_t {
+    std::uint32_t slot;
+    std::uint64_t sequence;
+    std::int64_t timestamp;
+    error_t error;
+};
+
+/**
+ * @brief Appends encoded errors to a fixed-size memory-mapped file. Appending
+ * only writes to the mapping, so the most recent errors remain in the file
+ * after the process crashes.
+ */
+class journal_t {
+    unsigned char* mapping_ = nullptr;
+    std::size_t size_ = 0;
+    std::uint32_t slot_count_ = 0;
+    std::uint32_t records_per_slot_ = 0;
+    std::uint32_t record_size_ = 0;
+
+    journal_t(unsigned char* mapping,
+      std::size_t size,
+      std::uint32_t slot_count,
+      std::uint32_t records_per_slot,
+      std::uint32_t record_size)
+    : mapping_(mapping)
+    , size_(size)
+    , slot_count_(slot_count)
+    , records_per_slot_(records_per_slot)
+    , record_size_(record_size) {
+    }
+
+    [[nodiscard]] static std::size_t slot_stride_(
+      std::uint32_t records_per_slot, std::uint32_t record_size) {
+        return detail::journal_slot_header_size
+          + (std::size_t{ records_per_slot } * record_size);
+    }
+
+  public:
+    /**
+     * @brief Open a journal file, creating it if it does not exist. An existing
+     * journal with the same geometry is reused and appended to. Any other
+     * non-empty file at the path is left untouched and an error is returned
+     * unless truncate is set, since it may hold the journal of a previous run.
+     *
+     * @param[in] path - The path to the journal file.
+     * @param[in] slot_count - The number of writer slots. Threads beyond this
+     * count share slots.
+     * @param[in] records_per_slot - The number of errors retained per slot.
+     * @param[in] record_size - The maximum size of a record in bytes. Must be a
+     * multiple of 64 bytes.
+     * @param[in] truncate - Overwrite a file at the path that is not a journal
+     * with this geometry.
+     */
+    [[nodiscard]] static optional_t<journal_t> open(const std::string& path,
+      std::uint32_t slot_count,
+      std::uint32_t records_per_slot,
+      std::uint32_t record_size = 1024,
+      bool truncate = false) {
+        if (slot_count == 0 || records_per_slot == 0) {
+            return RES_NEW_ERROR(
+              "A journal requires at least one slot and one record per slot.");
+        }
+        if (record_size <= detail::journal_record_header_size
+          || record_size % detail::journal_alignment != 0) {
+            return RES_NEW_ERROR(
+              "The journal record size must be a multiple of "
+              + std::to_string(detail::journal_alignment) + " bytes.");
+        }
+
+        const std::size_t size = detail::journal_header_size
+          + (std::size_t{ slot_count }
+            * slot_stride_(records_per_slot, record_size));
+
+        const int file = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (file < 0) {
+            return RES_NEW_ERROR("Failed to open the journal file \"" + path
+              + "\": " + detail::errno_message());
+        }
+
+        // Reuse an existing journal only if its geometry matches exactly.
+        detail::journal_header_t header{};
+        struct stat status {};
+        if (::fstat(file, &status) != 0) {
+            const std::string message = detail::errno_message();
+            ::close(file);
+            return RES_NEW_ERROR(
+              "Failed to read the journal file \"" + path + "\": " + message);
+        }
+        const bool reuse = static_cast<std::size_t>(status.st_size) == size
+          && ::pread(file, &header, sizeof(header), 0)
+            == static_cast<ssize_t>(sizeof(header))
+          && std::memcmp(header.magic, detail::journal_magic,
+               sizeof(header.magic))
+            == 0
+          && header.version == journal_version
+          && header.slot_count == slot_count
+          && header.records_per_slot == records_per_slot
+          && header.record_size == record_size;
+
+        if (! reuse && status.st_size != 0 && ! truncate) {
+            ::close(file);
+            return RES_NEW_ERROR("\"" + path
+              + "\" is not a journal with the requested geometry. Remove it "
+                "or open it with truncate set to overwrite it.");
+        }
+
+        if (! reuse
+          && (::ftruncate(file, 0) != 0
+            || ::ftruncate(file, static_cast<off_t>(size)) != 0)) {
+            const std::string message = detail::errno_message();
+            ::close(file);
+            return RES_NEW_ERROR(
+              "Failed to resize the journal file \"" + path + "\": " + message);
+        }
+
+        void* mapping =
+          ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        const std::string message = detail::errno_message();
+        ::close(file);
+        if (mapping == MAP_FAILED) {
+            return RES_NEW_ERROR(
+              "Failed to map the journal file \"" + path + "\": " + message);
+        }
+
+        auto* bytes = static_cast<unsigned char*>(mapping);
+        if (! reuse) {
+            std::memcpy(
+              header.magic, detail::journal_magic, sizeof(header.magic));
+            header.version = journal_version;
+            header.slot_count = slot_count;
+            header.records_per_slot = records_per_slot;
+            header.record_size = record_size;
+            std::memcpy(bytes, &header, sizeof(header));
+        }
+
+        return journal_t{
+            bytes, size, slot_count, records_per_slot, record_size
+        };
+    }
+
+    journal_t(const journal_t&) = delete;
+    journal_t(journal_t&& journal) noexcept
+    : mapping_(std::exchange(journal.mapping_, nullptr))
+    , size_(std::exchange(journal.size_, 0))
+    , slot_count_(journal.slot_count_)
+    , records_per_slot_(journal.records_per_slot_)
+    , record_size_(journal.record_size_) {
+    }
+    journal_t& operator=(const journal_t&) = delete;
+    journal_t& operator=(journal_t&& journal) noexcept {
+        if (this == &journal) {
+            return *this;
+        }
+
+        if (this->mapping_ != nullptr) {
+            ::munmap(this->mapping_, this->size_);
+        }
+        this->mapping_ = std::exchange(journal.mapping_, nullptr);
+        this->size_ = std::exchange(journal.size_, 0);
+        this->slot_count_ = journal.slot_count_;
+        this->records_per_slot_ = journal.records_per_slot_;
+        this->record_size_ = journal.record_size_;
+        return *this;
+    }
+
+    // Destructor
+    ~journal_t() {
+        if (this->mapping_ != nullptr) {
+            ::munmap(this->mapping_, this->size_);
+        }
+    }
+
+    /**
+     * @return the maximum size of an encoded error that fits in a record.
+     */
+    [[nodiscard]] std::size_t capacity() const {
+        return this->record_size_ - detail::journal_record_header_size;
+    }
+
+    /**
+     * @brief Append an error to the slot belonging to the calling thread. The
+     * oldest record in the slot is overwritten once the slot is full. Only
+     * the mapping is written and nothing is allocated unless the error does
+     * not fit.
+     *
+     * @return an error if the encoded error does not fit in a record. The
+     * journal is left unchanged in that case.
+     */
+    [[nodiscard]] result_t append(const error_t& error) {
+        // Size the encoding before claiming a record so that an error that
+        // does not fit never destroys an existing record.
+        detail::encoding_t encoding{ error.string(), std::nullopt };
+        const std::size_t size = encoding.size();
+        if (! encoding.representable() || size > this->capacity()) {
+            return RES_NEW_ERROR(
+              "The error is too large for a journal record ("
+              + std::to_string(size) + " bytes required, "
+              + std::to_string(this->capacity()) + " bytes available).");
+        }
+
+        const std::size_t slot_index =
+          detail::journal_thread_index() % this->slot_count_;
+        unsigned char* slot = this->mapping_ + detail::journal_header_size
+          + (slot_index
+            * slot_stride_(this->records_per_slot_, this->record_size_));
+
+        // The cursor only contends with other threads sharing this slot.
+        const std::uint64_t sequence =
+          detail::journal_word(slot).fetch_add(1, std::memory_order_relaxed)
+          + 1;
+        unsigned char* record = slot + detail::journal_slot_header_size
+          + (((sequence - 1) % this->records_per_slot_) * this->record_size_);
+
+        // Invalidate the record before overwriting it so that a crash halfway
+        // through the write never leaves a torn record behind.
+        std::atomic<std::uint64_t>& record_sequence =
+          detail::journal_word(record);
+        record_sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        encoding.write(record + detail::journal_record_header_size);
+
+        const std::int64_t timestamp =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+        const auto encoded_size = static_cast<std::uint32_t>(size);
+        std::memcpy(record + 8, &timestamp, sizeof(timestamp));
+        std::memcpy(record + 16, &encoded_size, sizeof(encoded_size));
+
+        record_sequence.store(sequence, std::memory_order_release);
+        return success;
+    }
+
+    /**
+     * @brief Flush the journal to disk. Not required to survive a crash of the
+     * process, only a crash of the operating system.
+     */
+    [[nodiscard]] result_t sync() const {
+        if (::msync(this->mapping_, this->size_, MS_SYNC) != 0) {
+            return RES_NEW_ERROR(
+              "Failed to flush the journal: " + detail::errno_message());
+        }
+        return success;
+    }
+};
+
+/**
+ * @brief Recover the errors retained by a journal file, oldest first. Records
+ * that were being written when the process stopped are skipped.
+ */
+[[nodiscard]] inline optional_t<std::vector<journal_entry_t>> read_journal(
+  const std::string& path) {
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return RES_NEW_ERROR("Failed to open the journal file \"" + path
+          + "\": " + detail::errno_message());
+    }
+
+    struct stat status {};
+    if (::fstat(file, &status) != 0) {
+        const std::string message = detail::errno_message();
+        ::close(file);
+        return RES_NEW_ERROR(
+          "Failed to read the journal file \"" + path + "\": " + message);
+    }
+    const auto size = static_cast<std::size_t>(status.st_size);
+    if (size < detail::journal_header_size) {
+        ::close(file);
+        return RES_NEW_ERROR("\"" + path + "\" is not a journal file.");
+    }
+
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    const std::string message = detail::errno_message();
+    ::close(file);
+    if (mapping == MAP_FAILED) {
+        return RES_NEW_ERROR(
+          "Failed to map the journal file \"" + path + "\": " + message);
+    }
+    const auto* bytes = static_cast<const unsigned char*>(mapping);
+    const auto unmap = [mapping, size]() { ::munmap(mapping, size); };
+
+    // Every count is checked against the file size before it is multiplied so
+    // that a corrupt header cannot overflow the layout computations.
+    detail::journal_header_t header{};
+    std::memcpy(&header, bytes, sizeof(header));
+    const std::size_t body_size = size - detail::journal_header_size;
+    const bool valid_geometry = header.slot_count != 0
+      && header.record_size > detail::journal_record_header_size
+      && header.record_size % detail::journal_alignment == 0
+      && header.records_per_slot <= body_size / header.record_size;
+    const std::size_t slot_stride = valid_geometry
+      ? detail::journal_slot_header_size
+        + (std::size_t{ header.records_per_slot } * header.record_size)
+      : 0;
+    if (std::memcmp(header.magic, detail::journal_magic, sizeof(header.magic))
+        != 0
+      || header.version != journal_version || ! valid_geometry
+      || header.slot_count > body_size / slot_stride
+      || header.slot_count * slot_stride != body_size) {
+        unmap();
+        return RES_NEW_ERROR("\"" + path + "\" is not a valid journal file.");
+    }
+
+    std::vector<journal_entry_t> entries;
+    std::vector<unsigned char> copy(header.record_size);
+    for (std::uint32_t slot = 0; slot < header.slot_count; ++slot) {
+        const unsigned char* records = bytes + detail::journal_header_size
+          + (slot * slot_stride) + detail::journal_slot_header_size;
+
+        for (std::uint32_t index = 0; index < header.records_per_slot;
+             ++index) {
+            const unsigned char* record =
+              records + (std::size_t{ index } * header.record_size);
+
+            // Copy the record so a live writer cannot change it while it is
+            // decoded, then check that it was not rewritten during the copy.
+            const std::uint64_t sequence = detail::journal_load(record);
+            if (sequence == 0) {
+                continue;
+            }
+            std::memcpy(copy.data(), record, copy.size());
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (detail::journal_load(record) != sequence) {
+                continue;
+            }
+
+            std::int64_t timestamp = 0;
+            std::uint32_t encoded_size = 0;
+            std::memcpy(&timestamp, copy.data() + 8, sizeof(timestamp));
+            std::memcpy(&encoded_size, copy.data() + 16, sizeof(encoded_size));
+            if (encoded_size
+              > header.record_size - detail::journal_record_header_size) {
+                continue;
+            }
+
+            error_view_t view;
+            if (view.read(copy.data() + detail::journal_record_header_size,
+                      encoded_size)
+                  .failure()) {
+                continue;
+            }
+            entries.push_back(
+              journal_entry_t{ slot, sequence, timestamp, view.to_error() });
+        }
+    }
+    unmap();
+
+    std::sort(entries.begin(),
+      entries.end(),
+      [](const journal_entry_t& lhs, const journal_entry_t& rhs) {
+          if (lhs.timestamp != rhs.timestamp) {
+              return lhs.timestamp < rhs.timestamp;
+          }
+          if (lhs.slot != rhs.slot) {
+              return lhs.slot < rhs.slot;
+          }
+          return lhs.sequence < rhs.sequence;
+      });
+    return entries;
+}
+
+} // namespace res
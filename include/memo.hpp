@@ -0,0 +1,331 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file memo.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief A concurrent memoization cache for functions returning optional_t.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Local includes
+#include "error.hpp"
+#include "optional.hpp"
+
+namespace res {
+
+/**
+ * @brief Configuration of a memo_cache_t.
+ */
+struct memo_options_t {
+    // How long values are cached.
+    std::chrono::nanoseconds success_ttl = std::chrono::minutes{ 1 };
+
+    // How long errors are cached. Zero disables caching of errors, although
+    // concurrent calls with the same key still share one error.
+    std::chrono::nanoseconds failure_ttl = std::chrono::seconds{ 5 };
+
+    // The number of independently locked partitions of the cache.
+    std::size_t shard_count = 16;
+};
+
+/**
+ * @brief Counters describing how lookups were served.
+ */
+struct memo_stats_t {
+    // Lookups served from the cache.
+    std::uint64_t hits = 0;
+
+    // Lookups that called the function.
+    std::uint64_t misses = 0;
+
+    // Lookups that waited for a concurrent call with the same key.
+    std::uint64_t coalesced = 0;
+};
+
+/**
+ * @brief Caches the values and errors returned by a function. Lookups with
+ * the same key that miss at the same time share a single call. Results are
+ * shared rather than copied, so neither values nor errors are copied on a
+ * hit. Read the error of a shared result with error_ref(), since error()
+ * returns a copy.
+ *
+ * @tparam key_t - The argument of the function.
+ * @tparam value_t - The value type of the optional_t returned by the function.
+ * @tparam hash_t - Hashes keys.
+ * @tparam time_source_t - Measures time to live.
+ */
+template<typename key_t,
+  typename value_t,
+  typename hash_t = std::hash<key_t>,
+  typename time_source_t = std::chrono::steady_clock>
+class memo_cache_t {
+  public:
+    using function_t = std::function<optional_t<value_t>(const key_t&)>;
+    using result_ptr_t = std::shared_ptr<const optional_t<value_t>>;
+
+  private:
+    // The result of a call in progress, shared with lookups that wait for it.
+    struct pending_t {
+        std::mutex mutex;
+        std::condition_variable condition;
+        result_ptr_t result;
+    };
+
+    struct entry_t {
+        result_ptr_t result;
+        typename time_source_t::time_point expiry;
+        std::shared_ptr<pending_t> pending;
+    };
+
+    // Aligned to separate the locks of neighboring shards.
+    struct alignas(64) shard_t {
+        std::mutex mutex;
+        std::unordered_map<key_t, entry_t, hash_t> entries;
+        memo_stats_t stats;
+    };
+
+    function_t function_;
+    memo_options_t options_;
+    hash_t hash_;
+    std::vector<std::unique_ptr<shard_t>> shards_;
+
+    static inline const std::string exception_message{
+        "The memoized function threw an exception."
+    };
+
+    [[nodiscard]] shard_t& shard_(const key_t& key) {
+        // Mix the hash so that shards do not share low bits with buckets.
+        // The product is computed in 64 bits even where std::size_t is
+        // narrower.
+        const std::uint64_t hash =
+          static_cast<std::uint64_t>(this->hash_(key)) * 0x9E3779B97F4A7C15ULL;
+        return *(this->shards_[static_cast<std::size_t>(
+          (hash >> 32U) % this->shards_.size())]);
+    }
+
+    [[nodiscard]] static result_ptr_t wait_(pending_t& pending) {
+        std::unique_lock<std::mutex> lock{ pending.mutex };
+        pending.condition.wait(
+          lock, [&pending] { return pending.result != nullptr; });
+        return pending.result;
+    }
+
+    static void complete_(pending_t& pending, result_ptr_t result) {
+        {
+            const std::lock_guard<std::mutex> lock{ pending.mutex };
+            pending.result = std::move(result);
+        }
+        pending.condition.notify_all();
+    }
+
+    void store_(shard_t& shard,
+      const key_t& key,
+      const std::shared_ptr<pending_t>& pending,
+      const result_ptr_t& result) {
+        const auto ttl = result->has_value() ? this->options_.success_ttl
+                                             : this->options_.failure_ttl;
+
+        const std::lock_guard<std::mutex> lock{ shard.mutex };
+        auto entry = shard.entries.find(key);
+        if (entry == shard.entries.end() || entry->second.pending != pending) {
+            // The entry was erased while the function was running.
+            return;
+        }
+        if (ttl <= std::chrono::nanoseconds::zero()) {
+            shard.entries.erase(entry);
+            return;
+        }
+
+        // Huge lifetimes, such as nanoseconds::max() for entries that never
+        // expire, saturate instead of overflowing.
+        using time_point_t = typename time_source_t::time_point;
+        const time_point_t now = time_source_t::now();
+        const auto lifetime =
+          std::chrono::duration_cast<typename time_source_t::duration>(ttl);
+        entry->second.result = result;
+        entry->second.expiry = (lifetime >= time_point_t::max() - now)
+          ? time_point_t::max()
+          : now + lifetime;
+        entry->second.pending = nullptr;
+    }
+
+  public:
+    explicit memo_cache_t(function_t function, memo_options_t options = {})
+    : function_(std::move(function)), options_(options) {
+        if (this->options_.shard_count == 0) {
+            this->options_.shard_count = 1;
+        }
+
+        this->shards_.reserve(this->options_.shard_count);
+        for (std::size_t index = 0; index < this->options_.shard_count;
+             ++index) {
+            this->shards_.push_back(std::make_unique<shard_t>());
+        }
+    }
+
+    /**
+     * @brief Get the cached result for a key, calling the function if there
+     * is no unexpired result. If another thread is already calling the
+     * function with the same key, wait for its result instead.
+     *
+     * @return the shared result of the function.
+     */
+    [[nodiscard]] result_ptr_t get(const key_t& key) {
+        shard_t& shard = this->shard_(key);
+        std::shared_ptr<pending_t> pending;
+        bool owner = false;
+
+        {
+            const std::lock_guard<std::mutex> lock{ shard.mutex };
+            entry_t& entry = shard.entries[key];
+
+            if (entry.pending != nullptr) {
+                ++shard.stats.coalesced;
+                pending = entry.pending;
+            } else if (entry.result != nullptr
+              && time_source_t::now() < entry.expiry) {
+                ++shard.stats.hits;
+                return entry.result;
+            } else {
+                ++shard.stats.misses;
+                entry.result = nullptr;
+                entry.pending = std::make_shared<pending_t>();
+                pending = entry.pending;
+                owner = true;
+            }
+        }
+
+        if (! owner) {
+            return wait_(*pending);
+        }
+
+        // Call the function without holding the lock of the shard.
+        result_ptr_t result;
+        try {
+            result = std::make_shared<const optional_t<value_t>>(
+              this->function_(key));
+        } catch (...) {
+            // Waiting lookups receive an error, which is never cached.
+            {
+                const std::lock_guard<std::mutex> lock{ shard.mutex };
+                auto entry = shard.entries.find(key);
+                if (entry != shard.entries.end()
+                  && entry->second.pending == pending) {
+                    shard.entries.erase(entry);
+                }
+            }
+            complete_(*pending,
+              std::make_shared<const optional_t<value_t>>(
+                RES_NEW_ERROR(exception_message)));
+            throw;
+        }
+
+        this->store_(shard, key, pending, result);
+        complete_(*pending, result);
+        return result;
+    }
+
+    /**
+     * @brief Remove the cached result for a key. A call in progress for the
+     * key still completes, but its result is not cached.
+     */
+    void erase(const key_t& key) {
+        shard_t& shard = this->shard_(key);
+        const std::lock_guard<std::mutex> lock{ shard.mutex };
+        shard.entries.erase(key);
+    }
+
+    /**
+     * @brief Remove all expired results.
+     */
+    void prune() {
+        const auto now = time_source_t::now();
+        for (const std::unique_ptr<shard_t>& shard : this->shards_) {
+            const std::lock_guard<std::mutex> lock{ shard->mutex };
+            for (auto entry = shard->entries.begin();
+                 entry != shard->entries.end();) {
+                if (entry->second.pending == nullptr
+                  && ! (now < entry->second.expiry)) {
+                    entry = shard->entries.erase(entry);
+                } else {
+                    ++entry;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Remove all cached results and reset the counters returned by
+     * stats().
+     */
+    void clear() {
+        for (const std::unique_ptr<shard_t>& shard : this->shards_) {
+            const std::lock_guard<std::mutex> lock{ shard->mutex };
+            shard->entries.clear();
+            shard->stats = memo_stats_t{};
+        }
+    }
+
+    /**
+     * @return the number of cached results and calls in progress, including
+     * expired results that have not been pruned.
+     */
+    [[nodiscard]] std::size_t size() const {
+        std::size_t size = 0;
+        for (const std::unique_ptr<shard_t>& shard : this->shards_) {
+            const std::lock_guard<std::mutex> lock{ shard->mutex };
+            size += shard->entries.size();
+        }
+        return size;
+    }
+
+    /**
+     * @return counters describing how lookups were served.
+     */
+    [[nodiscard]] memo_stats_t stats() const {
+        memo_stats_t stats;
+        for (const std::unique_ptr<shard_t>& shard : this->shards_) {
+            const std::lock_guard<std::mutex> lock{ shard->mutex };
+            stats.hits += shard->stats.hits;
+            stats.misses += shard->stats.misses;
+            stats.coalesced += shard->stats.coalesced;
+        }
+        return stats;
+    }
+};
+
+} // namespace res
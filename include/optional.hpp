@@ -29,10 +29,19 @@
  */
 
 // Standard includes
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#if __has_include(<expected>)
+#include <expected>
+#endif
 
 // Local includes
 #include "error.hpp"
+#include "result.hpp"
 
 namespace res {
 
@@ -69,7 +78,37 @@ class optional_t {
         "Attempted to access a value from an optional_t that does not exist."
     };
 
+    template<typename>
+    friend class optional_t;
+    friend struct detail::access_t;
+
+    // Take ownership of an error without allocating.
+    optional_t(detail::error_ptr_tag_t, std::unique_ptr<error_t>&& error)
+    : value_(nullptr), error_(std::move(error)) {
+    }
+
+    // Publish the address of this object, which contains neither a value nor
+    // an error until one is assigned through the slot.
+    optional_t(detail::slot_tag_t, optional_t** slot)
+    : value_(nullptr), error_(nullptr) {
+        *slot = this;
+    }
+
+    // A moved-from object contains neither a value nor an error, so the
+    // generic success message is propagated in that case.
+    [[nodiscard]] std::unique_ptr<error_t> copy_error_() const {
+        return std::make_unique<error_t>(this->error());
+    }
+    [[nodiscard]] std::unique_ptr<error_t> take_error_() {
+        if (! this->has_error()) {
+            return this->copy_error_();
+        }
+        return std::move(this->error_);
+    }
+
   public:
+    using value_type = type_t;
+
     // This object will always contain a value if it does not contain an error.
 
     // Initialize with an error.
@@ -124,6 +163,18 @@ class optional_t {
         }
     }
     optional_t(optional_t&&) = default;
+
+    // Copy the object referred to by an optional_t<type_t&>.
+    template<typename reference_t,
+      typename = std::enable_if_t<
+        std::is_same_v<std::remove_const_t<reference_t>, type_t>>>
+    explicit optional_t(const optional_t<reference_t&>& optional)
+    : value_(optional.has_value()
+          ? std::make_unique<type_t>(optional.value())
+          : nullptr),
+      error_(optional.has_value() ? nullptr : optional.copy_error_()) {
+    }
+
     optional_t& operator=(const optional_t& optional) {
         if (this == &optional) {
             return *this;
@@ -218,6 +269,840 @@ class optional_t {
 
         return *(this->error_);
     }
+
+    /**
+     * @return a const reference to the error stored within this object or a
+     * generic success message if this object does not contain an error. The
+     * reference is valid until this object is modified or destroyed.
+     */
+    [[nodiscard]] const error_t& error_ref() const {
+        if (! this->has_error()) {
+            return has_value_error;
+        }
+
+        return *(this->error_);
+    }
+
+    /**
+     * @brief Move the value stored within this object into a std::optional.
+     * The error, if any, is discarded.
+     */
+    [[nodiscard]] std::optional<type_t> to_std_optional() && {
+        if (! this->has_value()) {
+            return std::nullopt;
+        }
+        return std::optional<type_t>{ std::move(*(this->value_)) };
+    }
+
+#if defined(__cpp_lib_expected)
+    /**
+     * @brief Move the value or error stored within this object into a
+     * std::expected.
+     */
+    [[nodiscard]] std::expected<type_t, error_t> to_expected() && {
+        if (! this->has_value()) {
+            return std::unexpected<error_t>{ std::move(
+              *(this->take_error_())) };
+        }
+        return std::expected<type_t, error_t>{ std::move(*(this->value_)) };
+    }
+#endif
+
+    // Combinators
+    //
+    // Each combinator has overloads for lvalues, const lvalues, and rvalues.
+    // The rvalue overloads move the value or error along instead of copying
+    // it, and propagate errors without allocating. If a site is given (see
+    // RES_SITE), a trace for that site is appended to any error propagated
+    // from this object.
+
+    /**
+     * @brief Call a function returning an optional_t (or any other type
+     * constructible from an error) with the value stored within this object.
+     *
+     * @return the result of the function or the error stored within this
+     * object.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto and_then(
+      callable_t&& callable, const site_t& site = {}) & {
+        using returned_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t, type_t&>>>;
+        if (this->has_value()) {
+            return returned_t{ std::invoke(
+              std::forward<callable_t>(callable), *(this->value_)) };
+        }
+        return detail::propagate<returned_t>(this->copy_error_(), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto and_then(
+      callable_t&& callable, const site_t& site = {}) const& {
+        using returned_t = std::remove_cv_t<std::remove_reference_t<
+          std::invoke_result_t<callable_t, const type_t&>>>;
+        if (this->has_value()) {
+            return returned_t{ std::invoke(
+              std::forward<callable_t>(callable), *(this->value_)) };
+        }
+        return detail::propagate<returned_t>(this->copy_error_(), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto and_then(
+      callable_t&& callable, const site_t& site = {}) && {
+        using returned_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t, type_t&&>>>;
+        if (this->has_value()) {
+            return returned_t{ std::invoke(std::forward<callable_t>(callable),
+              std::move(*(this->value_))) };
+        }
+        return detail::propagate<returned_t>(this->take_error_(), site);
+    }
+
+    /**
+     * @brief Call a function with the value stored within this object.
+     *
+     * @return an optional_t containing the result of the function, which may
+     * be void, or the error stored within this object.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto transform(
+      callable_t&& callable, const site_t& site = {}) & {
+        using value_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t, type_t&>>>;
+        if (this->has_value()) {
+            return detail::invoke_transform<value_t>(
+              std::forward<callable_t>(callable), *(this->value_));
+        }
+        return detail::propagate<optional_t<value_t>>(
+          this->copy_error_(), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto transform(
+      callable_t&& callable, const site_t& site = {}) const& {
+        using value_t = std::remove_cv_t<std::remove_reference_t<
+          std::invoke_result_t<callable_t, const type_t&>>>;
+        if (this->has_value()) {
+            return detail::invoke_transform<value_t>(
+              std::forward<callable_t>(callable), *(this->value_));
+        }
+        return detail::propagate<optional_t<value_t>>(
+          this->copy_error_(), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto transform(
+      callable_t&& callable, const site_t& site = {}) && {
+        using value_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t, type_t&&>>>;
+        if (this->has_value()) {
+            return detail::invoke_transform<value_t>(
+              std::forward<callable_t>(callable), std::move(*(this->value_)));
+        }
+        return detail::propagate<optional_t<value_t>>(
+          this->take_error_(), site);
+    }
+
+    /**
+     * @brief Call a function returning an optional_t with the error stored
+     * within this object.
+     *
+     * @return the result of the function or this object if it contains a
+     * value.
+     */
+    template<typename callable_t>
+    [[nodiscard]] optional_t or_else(callable_t&& callable) & {
+        return std::as_const(*this).or_else(std::forward<callable_t>(callable));
+    }
+    template<typename callable_t>
+    [[nodiscard]] optional_t or_else(callable_t&& callable) const& {
+        if (this->has_value()) {
+            return *this;
+        }
+        return std::invoke(std::forward<callable_t>(callable), this->error());
+    }
+    template<typename callable_t>
+    [[nodiscard]] optional_t or_else(callable_t&& callable) && {
+        if (this->has_value()) {
+            return std::move(*this);
+        }
+        return std::invoke(std::forward<callable_t>(callable),
+          std::move(*(this->take_error_())));
+    }
+
+    /**
+     * @brief Call a function returning an error_t with the error stored within
+     * this object.
+     *
+     * @return an optional_t containing the result of the function or this
+     * object if it contains a value.
+     */
+    template<typename callable_t>
+    [[nodiscard]] optional_t transform_error(
+      callable_t&& callable, const site_t& site = {}) & {
+        return std::as_const(*this).transform_error(
+          std::forward<callable_t>(callable), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] optional_t transform_error(
+      callable_t&& callable, const site_t& site = {}) const& {
+        if (this->has_value()) {
+            return *this;
+        }
+        return detail::propagate<optional_t>(
+          std::make_unique<error_t>(
+            std::invoke(std::forward<callable_t>(callable), this->error())),
+          site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] optional_t transform_error(
+      callable_t&& callable, const site_t& site = {}) && {
+        if (this->has_value()) {
+            return std::move(*this);
+        }
+
+        // Reuse the allocation of the existing error.
+        std::unique_ptr<error_t> error = this->take_error_();
+        *error = std::invoke(
+          std::forward<callable_t>(callable), std::move(*error));
+        return detail::propagate<optional_t>(std::move(error), site);
+    }
 };
 
+/**
+ * @brief Refers to an existing object or contains an error message explaining
+ * why it does not. The object is never copied, so it must outlive this object.
+ * Like a pointer, a const optional_t<type_t&> still refers to a mutable
+ * object.
+ */
+template<typename type_t>
+class optional_t<type_t&> {
+    type_t* value_;
+    std::unique_ptr<error_t> error_;
+
+    static inline const error_t has_value_error{ "Has value" };
+    static inline const std::string bad_optional_access_message{
+        "Attempted to access a value from an optional_t that does not exist."
+    };
+
+    template<typename>
+    friend class optional_t;
+    friend struct detail::access_t;
+
+    // Take ownership of an error without allocating.
+    optional_t(detail::error_ptr_tag_t, std::unique_ptr<error_t>&& error)
+    : value_(nullptr), error_(std::move(error)) {
+    }
+
+    // Publish the address of this object, which refers to nothing and
+    // contains no error until one is assigned through the slot.
+    optional_t(detail::slot_tag_t, optional_t** slot)
+    : value_(nullptr), error_(nullptr) {
+        *slot = this;
+    }
+
+    [[nodiscard]] std::unique_ptr<error_t> copy_error_() const {
+        return std::make_unique<error_t>(this->error());
+    }
+    [[nodiscard]] std::unique_ptr<error_t> take_error_() {
+        if (! this->has_error()) {
+            return this->copy_error_();
+        }
+        return std::move(this->error_);
+    }
+
+  public:
+    using value_type = type_t&;
+
+    // Initialize with an error.
+    optional_t(const error_t& error)
+    : value_(nullptr), error_(std::make_unique<error_t>(error)) {
+    }
+    optional_t(error_t&& error)
+    : value_(nullptr), error_(std::make_unique<error_t>(std::move(error))) {
+    }
+    optional_t& operator=(const error_t& error) {
+        this->value_ = nullptr;
+        this->error_ = std::make_unique<error_t>(error);
+        return *this;
+    }
+    optional_t& operator=(error_t&& error) {
+        this->value_ = nullptr;
+        this->error_ = std::make_unique<error_t>(std::move(error));
+        return *this;
+    }
+
+    // Refer to an object. Assignment refers to a different object instead of
+    // assigning to the current one.
+    optional_t(type_t& value) : value_(std::addressof(value)), error_(nullptr) {
+    }
+    optional_t& operator=(type_t& value) {
+        this->value_ = std::addressof(value);
+        this->error_ = nullptr;
+        return *this;
+    }
+
+    // Temporaries would not outlive this object.
+    optional_t(const type_t&&) = delete;
+
+    // Refer to the value of another optional_t or copy its error.
+    template<typename other_t,
+      typename = std::enable_if_t<
+        std::is_same_v<std::remove_const_t<type_t>, other_t>>>
+    optional_t(optional_t<other_t>& optional)
+    : value_(optional.has_value() ? optional.value_.get() : nullptr),
+      error_(optional.has_value() ? nullptr : optional.copy_error_()) {
+    }
+    template<typename other_t,
+      typename = std::enable_if_t<std::is_const_v<type_t>
+        && std::is_same_v<std::remove_const_t<type_t>, other_t>>>
+    optional_t(const optional_t<other_t>& optional)
+    : value_(optional.has_value() ? optional.value_.get() : nullptr),
+      error_(optional.has_value() ? nullptr : optional.copy_error_()) {
+    }
+    template<typename other_t>
+    optional_t(optional_t<other_t>&& optional) = delete;
+
+    // Initialize with another optional object.
+    optional_t(const optional_t& optional)
+    : value_(optional.value_),
+      error_(optional.has_value() ? nullptr : optional.copy_error_()) {
+    }
+    optional_t(optional_t&&) = default;
+    optional_t& operator=(const optional_t& optional) {
+        if (this == &optional) {
+            return *this;
+        }
+
+        this->value_ = optional.value_;
+        this->error_ = optional.has_value() ? nullptr : optional.copy_error_();
+        return *this;
+    }
+    optional_t& operator=(optional_t&&) = default;
+
+    // Destructor
+    ~optional_t() = default;
+
+    /**
+     * @throw bad_optional_access_t if this object does not refer to an object.
+     * @return a pointer to the object referred to by this object.
+     */
+    [[nodiscard]] type_t* operator->() const {
+        if (! this->has_value()) {
+            throw bad_optional_access_t{ RES_ERROR(
+              this->error(), bad_optional_access_message) };
+        }
+
+        return this->value_;
+    }
+
+    /**
+     * @return true if this object refers to an object and false otherwise.
+     */
+    [[nodiscard]] bool has_value() const {
+        return this->value_ != nullptr;
+    }
+
+    /**
+     * @throw bad_optional_access_t if this object does not refer to an object.
+     * @return the object referred to by this object.
+     */
+    [[nodiscard]] type_t& value() const {
+        return *(this->operator->());
+    }
+
+    /**
+     * @return true if this object contains an error and false otherwise.
+     */
+    [[nodiscard]] bool has_error() const {
+        return this->error_ != nullptr;
+    }
+
+    /**
+     * @return a copy of the error stored within this object or a generic
+     * success message if this object does not contain an error.
+     */
+    [[nodiscard]] error_t error() const {
+        if (! this->has_error()) {
+            return has_value_error;
+        }
+
+        return *(this->error_);
+    }
+
+    /**
+     * @return a const reference to the error stored within this object or a
+     * generic success message if this object does not contain an error. The
+     * reference is valid until this object is modified or destroyed.
+     */
+    [[nodiscard]] const error_t& error_ref() const {
+        if (! this->has_error()) {
+            return has_value_error;
+        }
+
+        return *(this->error_);
+    }
+
+    // Combinators
+    //
+    // The referred object is passed to each function as an lvalue reference
+    // regardless of the value category of this object. The rvalue overloads
+    // move the error along instead of copying it.
+
+    /**
+     * @brief Call a function returning an optional_t (or any other type
+     * constructible from an error) with the object referred to by this object.
+     *
+     * @return the result of the function or the error stored within this
+     * object.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto and_then(
+      callable_t&& callable, const site_t& site = {}) const& {
+        using returned_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t, type_t&>>>;
+        if (this->has_value()) {
+            return returned_t{ std::invoke(
+              std::forward<callable_t>(callable), *(this->value_)) };
+        }
+        return detail::propagate<returned_t>(this->copy_error_(), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto and_then(
+      callable_t&& callable, const site_t& site = {}) && {
+        using returned_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t, type_t&>>>;
+        if (this->has_value()) {
+            return returned_t{ std::invoke(
+              std::forward<callable_t>(callable), *(this->value_)) };
+        }
+        return detail::propagate<returned_t>(this->take_error_(), site);
+    }
+
+    /**
+     * @brief Call a function with the object referred to by this object.
+     *
+     * @return an optional_t containing the result of the function, which may
+     * be void, or the error stored within this object.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto transform(
+      callable_t&& callable, const site_t& site = {}) const& {
+        using value_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t, type_t&>>>;
+        if (this->has_value()) {
+            return detail::invoke_transform<value_t>(
+              std::forward<callable_t>(callable), *(this->value_));
+        }
+        return detail::propagate<optional_t<value_t>>(
+          this->copy_error_(), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto transform(
+      callable_t&& callable, const site_t& site = {}) && {
+        using value_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t, type_t&>>>;
+        if (this->has_value()) {
+            return detail::invoke_transform<value_t>(
+              std::forward<callable_t>(callable), *(this->value_));
+        }
+        return detail::propagate<optional_t<value_t>>(
+          this->take_error_(), site);
+    }
+
+    /**
+     * @brief Call a function returning an optional_t with the error stored
+     * within this object.
+     *
+     * @return the result of the function or this object if it refers to an
+     * object.
+     */
+    template<typename callable_t>
+    [[nodiscard]] optional_t or_else(callable_t&& callable) const& {
+        if (this->has_value()) {
+            return *this;
+        }
+        return std::invoke(std::forward<callable_t>(callable), this->error());
+    }
+    template<typename callable_t>
+    [[nodiscard]] optional_t or_else(callable_t&& callable) && {
+        if (this->has_value()) {
+            return std::move(*this);
+        }
+        return std::invoke(std::forward<callable_t>(callable),
+          std::move(*(this->take_error_())));
+    }
+
+    /**
+     * @brief Call a function returning an error_t with the error stored within
+     * this object.
+     *
+     * @return an optional_t containing the result of the function or this
+     * object if it refers to an object.
+     */
+    template<typename callable_t>
+    [[nodiscard]] optional_t transform_error(
+      callable_t&& callable, const site_t& site = {}) const& {
+        if (this->has_value()) {
+            return *this;
+        }
+        return detail::propagate<optional_t>(
+          std::make_unique<error_t>(
+            std::invoke(std::forward<callable_t>(callable), this->error())),
+          site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] optional_t transform_error(
+      callable_t&& callable, const site_t& site = {}) && {
+        if (this->has_value()) {
+            return std::move(*this);
+        }
+
+        // Reuse the allocation of the existing error.
+        std::unique_ptr<error_t> error = this->take_error_();
+        *error = std::invoke(
+          std::forward<callable_t>(callable), std::move(*error));
+        return detail::propagate<optional_t>(std::move(error), site);
+    }
+};
+
+/**
+ * @brief Contains nothing or an error message. Has the same layout as
+ * result_t and converts to and from it without allocating, but offers the
+ * accessors of optional_t so generic code can treat it like any other
+ * optional_t.
+ */
+template<>
+class optional_t<void> {
+    std::unique_ptr<error_t> error_;
+
+    static inline const error_t has_value_error{ "Has value" };
+    static inline const std::string bad_optional_access_message{
+        "Attempted to access a value from an optional_t that does not exist."
+    };
+
+    template<typename>
+    friend class optional_t;
+    friend struct detail::access_t;
+
+    // Take ownership of an error without allocating.
+    optional_t(detail::error_ptr_tag_t, std::unique_ptr<error_t>&& error)
+    : error_(std::move(error)) {
+    }
+
+    // Publish the address of this object, which contains a value until an
+    // error is assigned through the slot.
+    optional_t(detail::slot_tag_t, optional_t** slot) {
+        *slot = this;
+    }
+
+    [[nodiscard]] std::unique_ptr<error_t> copy_error_() const {
+        return std::make_unique<error_t>(this->error());
+    }
+    [[nodiscard]] std::unique_ptr<error_t> take_error_() {
+        if (! this->has_error()) {
+            return this->copy_error_();
+        }
+        return std::move(this->error_);
+    }
+
+  public:
+    using value_type = void;
+
+    // Default construction indicates a value.
+    optional_t() = default;
+
+    // Initialize with an error.
+    optional_t(const error_t& error)
+    : error_(std::make_unique<error_t>(error)) {
+    }
+    optional_t(error_t&& error)
+    : error_(std::make_unique<error_t>(std::move(error))) {
+    }
+    optional_t& operator=(const error_t& error) {
+        this->error_ = std::make_unique<error_t>(error);
+        return *this;
+    }
+    optional_t& operator=(error_t&& error) {
+        this->error_ = std::make_unique<error_t>(std::move(error));
+        return *this;
+    }
+
+    // Convert from a result_t. Success becomes a value.
+    optional_t(const result_t& result)
+    : error_(result.success() ? nullptr
+                              : std::make_unique<error_t>(*(result.error_))) {
+    }
+    optional_t(result_t&& result) : error_(std::move(result.error_)) {
+    }
+
+    // Initialize with another optional object.
+    optional_t(const optional_t& optional)
+    : error_(optional.has_value() ? nullptr : optional.copy_error_()) {
+    }
+    optional_t(optional_t&&) = default;
+    optional_t& operator=(const optional_t& optional) {
+        if (this == &optional) {
+            return *this;
+        }
+
+        this->error_ = optional.has_value() ? nullptr : optional.copy_error_();
+        return *this;
+    }
+    optional_t& operator=(optional_t&&) = default;
+
+    // Destructor
+    ~optional_t() = default;
+
+    // Convert to a result_t. A value becomes success.
+    operator result_t() const& {
+        if (this->has_value()) {
+            return result_t{};
+        }
+        return result_t{ *(this->error_) };
+    }
+    operator result_t() && {
+        return detail::access_t::from_error<result_t>(std::move(this->error_));
+    }
+
+    /**
+     * @return true if this object contains a value and false otherwise.
+     */
+    [[nodiscard]] bool has_value() const {
+        return this->error_ == nullptr;
+    }
+
+    /**
+     * @throw bad_optional_access_t if this object does not contain a value.
+     */
+    void value() const {
+        if (! this->has_value()) {
+            throw bad_optional_access_t{ RES_ERROR(
+              this->error(), bad_optional_access_message) };
+        }
+    }
+
+    /**
+     * @return true if this object contains an error and false otherwise.
+     */
+    [[nodiscard]] bool has_error() const {
+        return this->error_ != nullptr;
+    }
+
+    /**
+     * @return a copy of the error stored within this object or a generic
+     * success message if this object does not contain an error.
+     */
+    [[nodiscard]] error_t error() const {
+        if (! this->has_error()) {
+            return has_value_error;
+        }
+
+        return *(this->error_);
+    }
+
+    /**
+     * @return a const reference to the error stored within this object or a
+     * generic success message if this object does not contain an error. The
+     * reference is valid until this object is modified or destroyed.
+     */
+    [[nodiscard]] const error_t& error_ref() const {
+        if (! this->has_error()) {
+            return has_value_error;
+        }
+
+        return *(this->error_);
+    }
+
+#if defined(__cpp_lib_expected)
+    /**
+     * @brief Move the error stored within this object, if any, into a
+     * std::expected.
+     */
+    [[nodiscard]] std::expected<void, error_t> to_expected() && {
+        if (! this->has_value()) {
+            return std::unexpected<error_t>{ std::move(
+              *(this->take_error_())) };
+        }
+        return std::expected<void, error_t>{};
+    }
+#endif
+
+    // Combinators
+    //
+    // Functions are called without arguments. The rvalue overloads move the
+    // error along instead of copying it.
+
+    /**
+     * @brief Call a function returning an optional_t (or any other type
+     * constructible from an error) if this object contains a value.
+     *
+     * @return the result of the function or the error stored within this
+     * object.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto and_then(
+      callable_t&& callable, const site_t& site = {}) const& {
+        using returned_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t>>>;
+        if (this->has_value()) {
+            return returned_t{ std::invoke(
+              std::forward<callable_t>(callable)) };
+        }
+        return detail::propagate<returned_t>(this->copy_error_(), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto and_then(
+      callable_t&& callable, const site_t& site = {}) && {
+        using returned_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t>>>;
+        if (this->has_value()) {
+            return returned_t{ std::invoke(
+              std::forward<callable_t>(callable)) };
+        }
+        return detail::propagate<returned_t>(this->take_error_(), site);
+    }
+
+    /**
+     * @brief Call a function if this object contains a value.
+     *
+     * @return an optional_t containing the result of the function, which may
+     * be void, or the error stored within this object.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto transform(
+      callable_t&& callable, const site_t& site = {}) const& {
+        using value_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t>>>;
+        if (this->has_value()) {
+            return detail::invoke_transform<value_t>(
+              std::forward<callable_t>(callable));
+        }
+        return detail::propagate<optional_t<value_t>>(
+          this->copy_error_(), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto transform(
+      callable_t&& callable, const site_t& site = {}) && {
+        using value_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t>>>;
+        if (this->has_value()) {
+            return detail::invoke_transform<value_t>(
+              std::forward<callable_t>(callable));
+        }
+        return detail::propagate<optional_t<value_t>>(
+          this->take_error_(), site);
+    }
+
+    /**
+     * @brief Call a function returning an optional_t with the error stored
+     * within this object.
+     *
+     * @return the result of the function or this object if it contains a
+     * value.
+     */
+    template<typename callable_t>
+    [[nodiscard]] optional_t or_else(callable_t&& callable) const& {
+        if (this->has_value()) {
+            return optional_t{};
+        }
+        return std::invoke(std::forward<callable_t>(callable), this->error());
+    }
+    template<typename callable_t>
+    [[nodiscard]] optional_t or_else(callable_t&& callable) && {
+        if (this->has_value()) {
+            return optional_t{};
+        }
+        return std::invoke(std::forward<callable_t>(callable),
+          std::move(*(this->take_error_())));
+    }
+
+    /**
+     * @brief Call a function returning an error_t with the error stored within
+     * this object.
+     *
+     * @return an optional_t containing the result of the function or this
+     * object if it contains a value.
+     */
+    template<typename callable_t>
+    [[nodiscard]] optional_t transform_error(
+      callable_t&& callable, const site_t& site = {}) const& {
+        if (this->has_value()) {
+            return optional_t{};
+        }
+        return detail::propagate<optional_t>(
+          std::make_unique<error_t>(
+            std::invoke(std::forward<callable_t>(callable), this->error())),
+          site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] optional_t transform_error(
+      callable_t&& callable, const site_t& site = {}) && {
+        if (this->has_value()) {
+            return optional_t{};
+        }
+
+        // Reuse the allocation of the existing error.
+        std::unique_ptr<error_t> error = this->take_error_();
+        *error = std::invoke(
+          std::forward<callable_t>(callable), std::move(*error));
+        return detail::propagate<optional_t>(std::move(error), site);
+    }
+};
+
+static_assert(sizeof(optional_t<void>) == sizeof(result_t),
+  "optional_t<void> must have the same layout as result_t.");
+
+namespace detail {
+
+template<typename type_t>
+struct is_error_owner<optional_t<type_t>> : std::true_type {};
+
+} // namespace detail
+
+#if defined(__cpp_lib_expected)
+
+namespace detail {
+
+/**
+ * @brief Convert the error of a std::expected to an error_t. Supports
+ * error_t, std::error_code, std::errc, and types convertible to std::string.
+ */
+template<typename error_type_t>
+[[nodiscard]] error_t to_error(error_type_t&& error) {
+    using decayed_t = std::decay_t<error_type_t>;
+    if constexpr (std::is_same_v<decayed_t, error_t>) {
+        return std::forward<error_type_t>(error);
+    } else if constexpr (std::is_same_v<decayed_t, std::error_code>) {
+        return error_t{ error };
+    } else if constexpr (std::is_same_v<decayed_t, std::errc>) {
+        return error_t{ std::make_error_code(error) };
+    } else {
+        static_assert(std::is_convertible_v<error_type_t, std::string>,
+          "The error type of the std::expected cannot be converted to an "
+          "error_t.");
+        return error_t{ std::string{ std::forward<error_type_t>(error) } };
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Move the value or error of a std::expected into an optional_t.
+ * std::expected<void, error_type_t> becomes optional_t<void>, which converts
+ * to result_t without allocating.
+ */
+template<typename type_t, typename error_type_t>
+[[nodiscard]] optional_t<type_t> from_expected(
+  std::expected<type_t, error_type_t>&& expected) {
+    if (! expected.has_value()) {
+        return optional_t<type_t>{ detail::to_error(
+          std::move(expected.error())) };
+    }
+    if constexpr (std::is_void_v<type_t>) {
+        return optional_t<void>{};
+    } else {
+        return optional_t<type_t>{ std::move(*expected) };
+    }
+}
+
+#endif
+
 } // namespace res
@@ -0,0 +1,430 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file parallel.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief Parallel algorithms over ranges of fallible operations.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Local includes
+#include "error.hpp"
+#include "executor.hpp"
+#include "future.hpp"
+#include "optional.hpp"
+#include "result.hpp"
+
+// Each algorithm splits a random access range into contiguous chunks and runs
+// them on an executor_t. The calling thread blocks until every chunk finishes,
+// so these algorithms must not be called from a task running on the same
+// executor.
+//
+// res::optional_t<std::vector<int>> parsed =
+//   res::parallel::transform(lines.begin(), lines.end(), parse);
+
+namespace res::parallel {
+
+/**
+ * @brief Which errors an algorithm reports.
+ */
+enum class errors_t {
+    // Stop all workers after the first failure and report the failure with
+    // the lowest index among those that occurred.
+    first,
+
+    // Process every element and report all failures in order.
+    all,
+};
+
+namespace detail {
+
+// Chunks per worker thread, so that workers that finish early can steal.
+constexpr inline std::size_t chunks_per_thread = 4;
+
+/**
+ * @brief The executor used by the overloads that do not take one.
+ */
+inline executor_t& default_executor() {
+    static executor_t executor;
+    return executor;
+}
+
+/**
+ * @brief The number of chunks a range of the given size is split into.
+ */
+[[nodiscard]] inline std::size_t chunk_count(
+  const executor_t& executor, std::size_t size) {
+    return std::min(size, executor.size() * chunks_per_thread);
+}
+
+/**
+ * @brief Records the failures of one chunk.
+ */
+class chunk_errors_t {
+    std::unique_ptr<error_t> error_;
+
+  public:
+    template<typename owner_t>
+    void add(owner_t& owner) {
+        std::unique_ptr<error_t> error =
+          res::detail::access_t::take_error(owner);
+        if (this->error_ == nullptr) {
+            this->error_ = std::move(error);
+        } else {
+            this->error_->string().append(error->string());
+        }
+    }
+
+    [[nodiscard]] bool empty() const {
+        return this->error_ == nullptr;
+    }
+
+    [[nodiscard]] std::unique_ptr<error_t> take() {
+        return std::move(this->error_);
+    }
+};
+
+/**
+ * @brief Run a function over chunks of the indices [0, size) on an executor
+ * and wait for all of them to finish.
+ *
+ * @param chunk - Called as chunk(index, begin, end, stop, errors) for the
+ * elements [begin, end) of the chunk with the given index. It should return
+ * early once stop is set and add its failures to errors. In errors_t::first
+ * mode it should set stop after its first failure.
+ * @return the failures of all chunks in order, or nullptr if there were none.
+ */
+template<typename chunk_t>
+[[nodiscard]] std::unique_ptr<error_t> run_chunks(
+  executor_t& executor, std::size_t size, errors_t mode, chunk_t& chunk) {
+    const std::size_t count = chunk_count(executor, size);
+    if (count == 0) {
+        return nullptr;
+    }
+
+    std::atomic<bool> stop{ false };
+    std::vector<chunk_errors_t> errors(count);
+    std::vector<future_t<bool>> futures;
+    futures.reserve(count);
+
+    for (std::size_t index = 0; index < count; ++index) {
+        const std::size_t begin = size * index / count;
+        const std::size_t end = size * (index + 1) / count;
+        futures.push_back(executor.async(
+          [&chunk, &stop, &errors = errors[index], index, begin, end] {
+              chunk(index, begin, end, stop, errors);
+              return optional_t<bool>{ true };
+          }));
+    }
+    for (std::size_t index = 0; index < count; ++index) {
+        // The future only fails if the chunk threw an exception.
+        optional_t<bool> finished = futures[index].get();
+        if (finished.has_error()) {
+            errors[index].add(finished);
+        }
+    }
+
+    std::unique_ptr<error_t> combined;
+    for (chunk_errors_t& chunk_errors : errors) {
+        if (chunk_errors.empty()) {
+            continue;
+        }
+        if (mode == errors_t::first) {
+            return chunk_errors.take();
+        }
+        if (combined == nullptr) {
+            combined = chunk_errors.take();
+        } else {
+            combined->string().append(chunk_errors.take()->string());
+        }
+    }
+    return combined;
+}
+
+template<typename iterator_t>
+void check_iterator() {
+    static_assert(
+      std::is_base_of_v<std::random_access_iterator_tag,
+        typename std::iterator_traits<iterator_t>::iterator_category>,
+      "Parallel algorithms require random access iterators.");
+}
+
+} // namespace detail
+
+/**
+ * @brief Apply a fallible function to every element of a range in parallel.
+ *
+ * @param executor - The executor to run on.
+ * @param first - The beginning of the range.
+ * @param last - The end of the range.
+ * @param callable - Called with each element and returns an optional_t.
+ * @param mode - Whether to stop at the first failure.
+ * @return the values in the order of their elements, or the failures.
+ */
+template<typename iterator_t, typename callable_t>
+[[nodiscard]] auto transform(executor_t& executor,
+  iterator_t first,
+  iterator_t last,
+  callable_t&& callable,
+  errors_t mode = errors_t::first) {
+    detail::check_iterator<iterator_t>();
+    using value_t = res::detail::optional_value_t<std::invoke_result_t<
+      callable_t&, typename std::iterator_traits<iterator_t>::reference>>;
+    static_assert(std::is_default_constructible_v<value_t>,
+      "The output is preallocated, so values must be default constructible.");
+    using returned_t = optional_t<std::vector<value_t>>;
+
+    // Chunks assign their values concurrently, so each value needs its own
+    // address. std::vector<bool> packs neighbouring values into one word.
+    const auto size = static_cast<std::size_t>(std::distance(first, last));
+    std::unique_ptr<value_t[]> values = std::make_unique<value_t[]>(size);
+
+    auto chunk = [&](std::size_t /* chunk_index */,
+                   std::size_t begin,
+                   std::size_t end,
+                   std::atomic<bool>& stop,
+                   detail::chunk_errors_t& errors) {
+        for (std::size_t index = begin; index < end; ++index) {
+            if (stop.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            auto result = callable(first[index]);
+            if (result.has_value()) {
+                values[index] = std::move(result.value());
+                continue;
+            }
+
+            errors.add(result);
+            if (mode == errors_t::first) {
+                stop.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    std::unique_ptr<error_t> error =
+      detail::run_chunks(executor, size, mode, chunk);
+    if (error != nullptr) {
+        return res::detail::propagate<returned_t>(std::move(error), RES_SITE);
+    }
+    return returned_t{ std::vector<value_t>(
+      std::make_move_iterator(values.get()),
+      std::make_move_iterator(values.get() + size)) };
+}
+
+/**
+ * @brief Apply a fallible function to every element of a range in parallel
+ * on the default executor.
+ */
+template<typename iterator_t, typename callable_t>
+[[nodiscard]] auto transform(iterator_t first,
+  iterator_t last,
+  callable_t&& callable,
+  errors_t mode = errors_t::first) {
+    return transform(detail::default_executor(),
+      first,
+      last,
+      std::forward<callable_t>(callable),
+      mode);
+}
+
+/**
+ * @brief Call a fallible function on every element of a range in parallel.
+ *
+ * @param executor - The executor to run on.
+ * @param first - The beginning of the range.
+ * @param last - The end of the range.
+ * @param callable - Called with each element and returns a result_t.
+ * @param mode - Whether to stop at the first failure.
+ * @return success or the failures.
+ */
+template<typename iterator_t, typename callable_t>
+[[nodiscard]] result_t for_each(executor_t& executor,
+  iterator_t first,
+  iterator_t last,
+  callable_t&& callable,
+  errors_t mode = errors_t::first) {
+    detail::check_iterator<iterator_t>();
+
+    const auto size = static_cast<std::size_t>(std::distance(first, last));
+    auto chunk = [&](std::size_t /* chunk_index */,
+                   std::size_t begin,
+                   std::size_t end,
+                   std::atomic<bool>& stop,
+                   detail::chunk_errors_t& errors) {
+        for (std::size_t index = begin; index < end; ++index) {
+            if (stop.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            result_t result = callable(first[index]);
+            if (result.success()) {
+                continue;
+            }
+
+            errors.add(result);
+            if (mode == errors_t::first) {
+                stop.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    std::unique_ptr<error_t> error =
+      detail::run_chunks(executor, size, mode, chunk);
+    if (error != nullptr) {
+        return res::detail::propagate<result_t>(std::move(error), RES_SITE);
+    }
+    return res::success;
+}
+
+/**
+ * @brief Call a fallible function on every element of a range in parallel on
+ * the default executor.
+ */
+template<typename iterator_t, typename callable_t>
+[[nodiscard]] result_t for_each(iterator_t first,
+  iterator_t last,
+  callable_t&& callable,
+  errors_t mode = errors_t::first) {
+    return for_each(detail::default_executor(),
+      first,
+      last,
+      std::forward<callable_t>(callable),
+      mode);
+}
+
+/**
+ * @brief Apply a fallible function to every element of a range and combine
+ * the values in parallel. Values are combined within each chunk and then the
+ * chunks are combined in order, so the reduction must be associative.
+ *
+ * @param executor - The executor to run on.
+ * @param first - The beginning of the range.
+ * @param last - The end of the range.
+ * @param init - The initial value.
+ * @param reduce - Combines two values.
+ * @param callable - Called with each element and returns an optional_t.
+ * @param mode - Whether to stop at the first failure.
+ * @return the combined value or the failures.
+ */
+template<typename iterator_t,
+  typename value_t,
+  typename reduce_t,
+  typename callable_t>
+[[nodiscard]] optional_t<value_t> transform_reduce(executor_t& executor,
+  iterator_t first,
+  iterator_t last,
+  value_t init,
+  reduce_t&& reduce,
+  callable_t&& callable,
+  errors_t mode = errors_t::first) {
+    detail::check_iterator<iterator_t>();
+
+    const auto size = static_cast<std::size_t>(std::distance(first, last));
+    std::vector<std::optional<value_t>> partials(
+      detail::chunk_count(executor, size));
+
+    auto chunk = [&](std::size_t chunk_index,
+                   std::size_t begin,
+                   std::size_t end,
+                   std::atomic<bool>& stop,
+                   detail::chunk_errors_t& errors) {
+        std::optional<value_t>& partial = partials[chunk_index];
+
+        for (std::size_t index = begin; index < end; ++index) {
+            if (stop.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            auto result = callable(first[index]);
+            if (result.has_value()) {
+                if (partial.has_value()) {
+                    partial = reduce(
+                      std::move(*partial), std::move(result.value()));
+                } else {
+                    partial.emplace(std::move(result.value()));
+                }
+                continue;
+            }
+
+            errors.add(result);
+            if (mode == errors_t::first) {
+                stop.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    std::unique_ptr<error_t> error =
+      detail::run_chunks(executor, size, mode, chunk);
+    if (error != nullptr) {
+        return res::detail::propagate<optional_t<value_t>>(
+          std::move(error), RES_SITE);
+    }
+
+    for (std::optional<value_t>& partial : partials) {
+        if (partial.has_value()) {
+            init = reduce(std::move(init), std::move(*partial));
+        }
+    }
+    return init;
+}
+
+/**
+ * @brief Apply a fallible function to every element of a range and combine
+ * the values in parallel on the default executor.
+ */
+template<typename iterator_t,
+  typename value_t,
+  typename reduce_t,
+  typename callable_t>
+[[nodiscard]] optional_t<value_t> transform_reduce(iterator_t first,
+  iterator_t last,
+  value_t init,
+  reduce_t&& reduce,
+  callable_t&& callable,
+  errors_t mode = errors_t::first) {
+    return transform_reduce(detail::default_executor(),
+      first,
+      last,
+      std::move(init),
+      std::forward<reduce_t>(reduce),
+      std::forward<callable_t>(callable),
+      mode);
+}
+
+} // namespace res::parallel
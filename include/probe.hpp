@@ -0,0 +1,162 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file probe.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief SystemTap-style static probes fired when errors are created and
+ * propagated.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+
+// Probes are compiled in only if RES_PROBES is defined before this header is
+// included. They are emitted as SDT notes (the format <sys/sdt.h> produces)
+// that tools such as bpftrace, perf, and SystemTap attach to by name:
+//
+//   bpftrace -e 'usdt:./program:res:new_error { @[str(arg0)] = count(); }'
+//
+// If <sys/sdt.h> is available, the probes are emitted with its DTRACE_PROBE5
+// macro and are supported on every ELF target it supports. Otherwise they are
+// emitted by equivalent inline assembly, which is only written for x86-64.
+// Probes are compiled out elsewhere. Each probe has a semaphore that tracers
+// increment when they attach, so the arguments are not even computed while no
+// tracer is attached. If <sys/sdt.h> is included before this header, it must
+// be included with _SDT_HAS_SEMAPHORES defined.
+//
+// Every probe takes the same five arguments:
+//   arg0  const char*   file name
+//   arg1  const char*   function name
+//   arg2  std::uint32_t line number
+//   arg3  const char*   message (not null-terminated, may be null)
+//   arg4  std::size_t   message length
+
+#if defined(RES_PROBES) && defined(__ELF__) && defined(__GNUC__)
+#if __has_include(<sys/sdt.h>)
+#define RES_PROBES_ENABLED 1
+#define RES_PROBES_SDT_H_ 1
+#elif defined(__x86_64__)
+#define RES_PROBES_ENABLED 1
+#define RES_PROBES_SDT_H_ 0
+#else
+#define RES_PROBES_ENABLED 0
+#endif
+#else
+#define RES_PROBES_ENABLED 0
+#endif
+
+#if RES_PROBES_ENABLED
+
+// Define the semaphore for a probe. The assembler symbol name is fixed so that
+// the probe note can refer to it.
+#define RES_PROBE_SEMAPHORE_(name)                                             \
+    inline volatile unsigned short name##_semaphore                            \
+      __asm__("res_" #name "_semaphore")                                       \
+        __attribute__((section(".probes"), used)) = 0
+
+#if RES_PROBES_SDT_H_
+
+// The note refers to the semaphore as "<provider>_<name>_semaphore", which is
+// the assembler symbol name given by RES_PROBE_SEMAPHORE_.
+#ifndef _SDT_HAS_SEMAPHORES
+#define _SDT_HAS_SEMAPHORES 1
+#endif
+
+// POSIX includes
+#include <sys/sdt.h>
+
+#define RES_PROBE_(name, arg0, arg1, arg2, arg3, arg4)                         \
+    DTRACE_PROBE5(res, name, arg0, arg1, arg2, arg3, arg4)
+
+#else
+
+// Emit a probe site and its SDT note the same way <sys/sdt.h> does. The "%n"
+// operand modifier prints the negated argument size, so unsigned arguments are
+// described as "8@..." and signed arguments as "-8@...".
+#define RES_PROBE_(name, arg0, arg1, arg2, arg3, arg4)                         \
+    __asm__ __volatile__(                                                      \
+      "990: nop\n"                                                             \
+      ".pushsection .note.stapsdt,\"?\",\"note\"\n"                            \
+      ".balign 4\n"                                                            \
+      ".4byte 992f-991f, 994f-993f, 3\n"                                       \
+      "991: .asciz \"stapsdt\"\n"                                              \
+      "992: .balign 4\n"                                                       \
+      "993: .8byte 990b\n"                                                     \
+      ".8byte _.stapsdt.base\n"                                                \
+      ".8byte res_" #name "_semaphore\n"                                       \
+      ".asciz \"res\"\n"                                                       \
+      ".asciz \"" #name "\"\n"                                                 \
+      ".asciz \"%n[file_size]@%[file] %n[function_size]@%[function] "          \
+      "%n[line_size]@%[line] %n[message_size]@%[message] "                     \
+      "%n[length_size]@%[length]\"\n"                                          \
+      "994: .balign 4\n"                                                       \
+      ".popsection\n"                                                          \
+      ".ifndef _.stapsdt.base\n"                                               \
+      ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"  \
+      ".weak _.stapsdt.base\n"                                                 \
+      ".hidden _.stapsdt.base\n"                                               \
+      "_.stapsdt.base: .space 1\n"                                             \
+      ".size _.stapsdt.base, 1\n"                                              \
+      ".popsection\n"                                                          \
+      ".endif\n"                                                               \
+      :                                                                        \
+      : [file_size] "n"(-8), [file] "nor"(arg0), [function_size] "n"(-8),      \
+      [function] "nor"(arg1), [line_size] "n"(-4), [line] "nor"(arg2),         \
+      [message_size] "n"(-8), [message] "nor"(arg3), [length_size] "n"(-8),    \
+      [length] "nor"(arg4))
+
+#endif
+
+namespace res::detail {
+
+RES_PROBE_SEMAPHORE_(new_error);
+RES_PROBE_SEMAPHORE_(trace);
+RES_PROBE_SEMAPHORE_(error);
+
+} // namespace res::detail
+
+// Fire a probe if a tracer is attached to it. The message is passed as a
+// pointer and length since it is not necessarily null-terminated.
+#define RES_FIRE_PROBE(name, site, message)                                    \
+    do {                                                                       \
+        if (res::detail::name##_semaphore != 0) {                              \
+            const char* probe_file_ = (site).file.data();                      \
+            const char* probe_function_ = (site).function.data();              \
+            const std::uint32_t probe_line_ = (site).line;                     \
+            const char* probe_message_ = (message).data();                     \
+            const std::size_t probe_length_ = (message).size();                \
+            RES_PROBE_(name, probe_file_, probe_function_, probe_line_,        \
+              probe_message_, probe_length_);                                  \
+        }                                                                      \
+    } while (false)
+
+#else
+
+#define RES_FIRE_PROBE(name, site, message)                                    \
+    do {                                                                       \
+    } while (false)
+
+#endif
@@ -29,13 +29,44 @@
  */
 
 // Standard includes
+#include <functional>
 #include <memory>
+#include <type_traits>
+#include <utility>
+#if __has_include(<expected>)
+#include <expected>
+#endif
 
 // Local includes
 #include "error.hpp"
 
 namespace res {
 
+// Defined in optional.hpp, which must be included to call result_t::transform.
+template<typename type_t>
+class optional_t;
+
+namespace detail {
+
+/**
+ * @brief Call a function and wrap its result in an optional_t. Functions
+ * returning void produce an optional_t<void> that indicates a value.
+ */
+template<typename value_t, typename callable_t, typename... args_t>
+[[nodiscard]] optional_t<value_t> invoke_transform(
+  callable_t&& callable, args_t&&... args) {
+    if constexpr (std::is_void_v<value_t>) {
+        std::invoke(
+          std::forward<callable_t>(callable), std::forward<args_t>(args)...);
+        return optional_t<value_t>{};
+    } else {
+        return optional_t<value_t>{ std::invoke(
+          std::forward<callable_t>(callable), std::forward<args_t>(args)...) };
+    }
+}
+
+} // namespace detail
+
 /**
  * @brief Indicates success or failure. Contains an error message for failure
  * and an empty string for success.
@@ -45,7 +76,31 @@ class result_t {
 
     static inline const error_t success_error{ "Success" };
 
+    template<typename>
+    friend class optional_t;
+    friend struct detail::access_t;
+
+    // Take ownership of an error without allocating.
+    result_t(detail::error_ptr_tag_t, std::unique_ptr<error_t>&& error)
+    : error_(std::move(error)) {
+    }
+
+    // Publish the address of this object, which represents success until an
+    // error is assigned through the slot.
+    result_t(detail::slot_tag_t, result_t** slot) {
+        *slot = this;
+    }
+
+    [[nodiscard]] std::unique_ptr<error_t> take_error_() {
+        if (this->success()) {
+            return std::make_unique<error_t>(success_error);
+        }
+        return std::move(this->error_);
+    }
+
   public:
+    using value_type = void;
+
     // Default construction indicates success.
     result_t() {
     }
@@ -103,15 +158,171 @@ class result_t {
      * @return a copy of the error stored within this result or a
      * generic success message if this result represents success.
      */
-    [[nodiscard]] error_t error() {
+    [[nodiscard]] error_t error() const {
         if (this->success()) {
             return success_error;
         }
 
         return *(this->error_);
     }
+
+    /**
+     * @return a const reference to the error stored within this result or a
+     * generic success message if this result represents success. The
+     * reference is valid until this result is modified or destroyed.
+     */
+    [[nodiscard]] const error_t& error_ref() const {
+        if (this->success()) {
+            return success_error;
+        }
+
+        return *(this->error_);
+    }
+
+#if defined(__cpp_lib_expected)
+    /**
+     * @brief Move the error stored within this result, if any, into a
+     * std::expected.
+     */
+    [[nodiscard]] std::expected<void, error_t> to_expected() && {
+        if (this->success()) {
+            return std::expected<void, error_t>{};
+        }
+        return std::unexpected<error_t>{ std::move(*(this->error_)) };
+    }
+#endif
+
+    // Combinators
+    //
+    // A result_t has no value, so the lvalue overloads are shared by const and
+    // non-const objects. The rvalue overloads move the error along instead of
+    // copying it. If a site is given (see RES_SITE), a trace for that site is
+    // appended to any error propagated from this object.
+
+    /**
+     * @brief Call a function returning a result_t, an optional_t, or any other
+     * type constructible from an error if this result represents success.
+     *
+     * @return the result of the function or the error stored within this
+     * result.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto and_then(
+      callable_t&& callable, const site_t& site = {}) const& {
+        using returned_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t>>>;
+        if (this->success()) {
+            return returned_t{ std::invoke(
+              std::forward<callable_t>(callable)) };
+        }
+        return detail::propagate<returned_t>(
+          std::make_unique<error_t>(*(this->error_)), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto and_then(
+      callable_t&& callable, const site_t& site = {}) && {
+        using returned_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t>>>;
+        if (this->success()) {
+            return returned_t{ std::invoke(
+              std::forward<callable_t>(callable)) };
+        }
+        return detail::propagate<returned_t>(std::move(this->error_), site);
+    }
+
+    /**
+     * @brief Call a function if this result represents success.
+     *
+     * @return an optional_t containing the result of the function, which may
+     * be void, or the error stored within this result.
+     */
+    template<typename callable_t>
+    [[nodiscard]] auto transform(
+      callable_t&& callable, const site_t& site = {}) const& {
+        using value_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t>>>;
+        if (this->success()) {
+            return detail::invoke_transform<value_t>(
+              std::forward<callable_t>(callable));
+        }
+        return detail::propagate<optional_t<value_t>>(
+          std::make_unique<error_t>(*(this->error_)), site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] auto transform(
+      callable_t&& callable, const site_t& site = {}) && {
+        using value_t = std::remove_cv_t<
+          std::remove_reference_t<std::invoke_result_t<callable_t>>>;
+        if (this->success()) {
+            return detail::invoke_transform<value_t>(
+              std::forward<callable_t>(callable));
+        }
+        return detail::propagate<optional_t<value_t>>(
+          std::move(this->error_), site);
+    }
+
+    /**
+     * @brief Call a function returning a result_t with the error stored within
+     * this result.
+     *
+     * @return the result of the function or success.
+     */
+    template<typename callable_t>
+    [[nodiscard]] result_t or_else(callable_t&& callable) const& {
+        if (this->success()) {
+            return result_t{};
+        }
+        return std::invoke(
+          std::forward<callable_t>(callable), std::as_const(*(this->error_)));
+    }
+    template<typename callable_t>
+    [[nodiscard]] result_t or_else(callable_t&& callable) && {
+        if (this->success()) {
+            return result_t{};
+        }
+        return std::invoke(
+          std::forward<callable_t>(callable), std::move(*(this->error_)));
+    }
+
+    /**
+     * @brief Call a function returning an error_t with the error stored within
+     * this result.
+     *
+     * @return a result containing the result of the function or success.
+     */
+    template<typename callable_t>
+    [[nodiscard]] result_t transform_error(
+      callable_t&& callable, const site_t& site = {}) const& {
+        if (this->success()) {
+            return result_t{};
+        }
+        return detail::propagate<result_t>(
+          std::make_unique<error_t>(
+            std::invoke(std::forward<callable_t>(callable),
+              std::as_const(*(this->error_)))),
+          site);
+    }
+    template<typename callable_t>
+    [[nodiscard]] result_t transform_error(
+      callable_t&& callable, const site_t& site = {}) && {
+        if (this->success()) {
+            return result_t{};
+        }
+
+        // Reuse the allocation of the existing error.
+        *(this->error_) = std::invoke(
+          std::forward<callable_t>(callable), std::move(*(this->error_)));
+        return detail::propagate<result_t>(std::move(this->error_), site);
+    }
 };
 
+namespace detail {
+
+template<>
+struct is_error_owner<result_t> : std::true_type {};
+
+} // namespace detail
+
 /**
  * @brief A result indicating success.
  */
@@ -0,0 +1,587 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file serialize.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief A compact binary encoding for errors and a zero-copy decoder.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Local includes
+#include "error.hpp"
+#include "optional.hpp"
+#include "result.hpp"
+#include "trace.hpp"
+
+// Encoding (version 1, all integers are little-endian):
+//
+//   header (32 bytes):
+//     u8[3] magic          "RES"
+//     u8    version        encoding_version
+//     u32   flags          bit 0: has code, bit 1: trailing newline
+//     i64   code           zero if bit 0 of flags is clear
+//     u32   string_count
+//     u32   frame_count
+//     u32   blob_size
+//     u32   reserved       zero
+//   strings (string_count * 8 bytes):
+//     u32   offset         relative to the start of the blob
+//     u32   size
+//   frames (frame_count * 20 bytes):
+//     u32   kind           frame_kind_t
+//     u32   file           string index (site frames only)
+//     u32   function       string index (site frames only)
+//     u32   line           line number (site frames only)
+//     u32   message        string index (frames with messages only)
+//   blob (blob_size bytes)
+//
+// Every distinct string is stored once in the blob, so repeated files,
+// functions, and messages cost one string index per frame. Strings may also be
+// stored more than once (see encoding_intern_slots).
+
+namespace res {
+
+constexpr inline std::uint8_t encoding_version = 1;
+
+namespace detail {
+
+constexpr inline char encoding_magic[3] = { 'R', 'E', 'S' };
+constexpr inline std::size_t encoding_header_size = 32;
+constexpr inline std::size_t encoding_string_size = 8;
+constexpr inline std::size_t encoding_frame_size = 20;
+
+constexpr inline std::uint32_t encoding_flag_code = 1U << 0U;
+constexpr inline std::uint32_t encoding_flag_newline = 1U << 1U;
+constexpr inline std::uint32_t encoding_flags =
+  encoding_flag_code | encoding_flag_newline;
+
+enum class frame_kind_t : std::uint32_t {
+    text = 0,
+    site = 1,
+    site_message = 2,
+};
+
+inline void store_u32(unsigned char* output, std::uint32_t value) {
+    for (std::size_t byte = 0; byte < 4; ++byte) {
+        output[byte] = static_cast<unsigned char>(value >> (byte * 8));
+    }
+}
+
+inline void store_u64(unsigned char* output, std::uint64_t value) {
+    for (std::size_t byte = 0; byte < 8; ++byte) {
+        output[byte] = static_cast<unsigned char>(value >> (byte * 8));
+    }
+}
+
+inline std::uint32_t load_u32(const unsigned char* input) {
+    std::uint32_t value = 0;
+    for (std::size_t byte = 0; byte < 4; ++byte) {
+        value |= static_cast<std::uint32_t>(input[byte]) << (byte * 8);
+    }
+    return value;
+}
+
+inline std::uint64_t load_u64(const unsigned char* input) {
+    std::uint64_t value = 0;
+    for (std::size_t byte = 0; byte < 8; ++byte) {
+        value |= static_cast<std::uint64_t>(input[byte]) << (byte * 8);
+    }
+    return value;
+}
+
+// The number of hash table slots used to intern strings while encoding. At
+// most three quarters of them are filled. Any further distinct strings are
+// stored once per use instead, so encoding never allocates.
+constexpr inline std::size_t encoding_intern_slots = 128;
+
+/**
+ * @brief Encodes an error in two passes over its text. The first pass (run by
+ * the constructor) interns strings and counts frames so the exact encoded size
+ * is known before anything is written. The second pass (run by write()) repeats
+ * the same steps while writing. Neither pass allocates.
+ */
+class encoding_t {
+    struct interned_t {
+        std::string_view string;
+        // One more than the string index, or zero if the slot is empty.
+        std::uint32_t index = 0;
+    };
+
+    std::string_view text_;
+    std::uint32_t flags_ = 0;
+    std::int64_t code_ = 0;
+
+    std::array<interned_t, encoding_intern_slots> interned_{};
+    std::size_t interned_count_ = 0;
+    std::uint64_t string_count_ = 0;
+    std::uint64_t frame_count_ = 0;
+    std::uint64_t blob_size_ = 0;
+
+    // Where the next string entry, frame, and blob byte are written. Null
+    // during the first pass.
+    unsigned char* entry_ = nullptr;
+    unsigned char* frame_ = nullptr;
+    unsigned char* blob_ = nullptr;
+
+    std::uint32_t intern_(std::string_view string) {
+        std::size_t slot = std::hash<std::string_view>{}(string)
+          & (encoding_intern_slots - 1);
+        while (this->interned_[slot].index != 0) {
+            if (this->interned_[slot].string == string) {
+                return this->interned_[slot].index - 1;
+            }
+            slot = (slot + 1) & (encoding_intern_slots - 1);
+        }
+
+        const auto index = static_cast<std::uint32_t>(this->string_count_);
+        ++this->string_count_;
+        if (this->interned_count_ < (encoding_intern_slots / 4) * 3) {
+            this->interned_[slot] = interned_t{ string, index + 1 };
+            ++this->interned_count_;
+        }
+
+        if (this->entry_ != nullptr) {
+            store_u32(
+              this->entry_, static_cast<std::uint32_t>(this->blob_size_));
+            store_u32(
+              this->entry_ + 4, static_cast<std::uint32_t>(string.size()));
+            this->entry_ += encoding_string_size;
+            if (! string.empty()) {
+                std::memcpy(this->blob_ + this->blob_size_,
+                  string.data(),
+                  string.size());
+            }
+        }
+        this->blob_size_ += string.size();
+        return index;
+    }
+
+    void scan_() {
+        this->interned_.fill(interned_t{});
+        this->interned_count_ = 0;
+        this->string_count_ = 0;
+        this->frame_count_ = 0;
+        this->blob_size_ = 0;
+
+        for_each_line(this->text_, [this](std::string_view line) {
+            const frame_t frame = parse_frame(line);
+
+            frame_kind_t kind = frame_kind_t::text;
+            std::uint32_t file = 0;
+            std::uint32_t function = 0;
+            std::uint32_t message = 0;
+            if (frame.has_site) {
+                kind = frame.has_message ? frame_kind_t::site_message
+                                         : frame_kind_t::site;
+                file = this->intern_(frame.file);
+                function = this->intern_(frame.function);
+            }
+            if (frame.has_message) {
+                message = this->intern_(frame.message);
+            }
+
+            if (this->frame_ != nullptr) {
+                store_u32(this->frame_, static_cast<std::uint32_t>(kind));
+                store_u32(this->frame_ + 4, file);
+                store_u32(this->frame_ + 8, function);
+                store_u32(this->frame_ + 12, frame.line);
+                store_u32(this->frame_ + 16, message);
+                this->frame_ += encoding_frame_size;
+            }
+            ++this->frame_count_;
+        });
+    }
+
+  public:
+    encoding_t(std::string_view text, std::optional<std::int64_t> code)
+    : text_(text) {
+        if (code.has_value()) {
+            this->flags_ |= encoding_flag_code;
+            this->code_ = *code;
+        }
+        if (! text.empty() && text.back() == '\n') {
+            this->flags_ |= encoding_flag_newline;
+        }
+        this->scan_();
+    }
+
+    /**
+     * @return true if every count and offset fits in the encoding.
+     */
+    [[nodiscard]] bool representable() const {
+        return this->blob_size_ <= UINT32_MAX
+          && this->string_count_ <= UINT32_MAX
+          && this->frame_count_ <= UINT32_MAX;
+    }
+
+    /**
+     * @return the exact number of bytes written by write().
+     */
+    [[nodiscard]] std::size_t size() const {
+        return static_cast<std::size_t>(encoding_header_size
+          + (this->string_count_ * encoding_string_size)
+          + (this->frame_count_ * encoding_frame_size) + this->blob_size_);
+    }
+
+    /**
+     * @brief Write exactly size() bytes to the output.
+     */
+    void write(unsigned char* output) {
+        std::memcpy(output, encoding_magic, sizeof(encoding_magic));
+        output[3] = encoding_version;
+        store_u32(output + 4, this->flags_);
+        store_u64(output + 8, static_cast<std::uint64_t>(this->code_));
+        store_u32(output + 16, static_cast<std::uint32_t>(this->string_count_));
+        store_u32(output + 20, static_cast<std::uint32_t>(this->frame_count_));
+        store_u32(output + 24, static_cast<std::uint32_t>(this->blob_size_));
+        store_u32(output + 28, 0);
+
+        this->entry_ = output + encoding_header_size;
+        this->frame_ = this->entry_
+          + (static_cast<std::size_t>(this->string_count_)
+            * encoding_string_size);
+        this->blob_ = this->frame_
+          + (static_cast<std::size_t>(this->frame_count_)
+            * encoding_frame_size);
+        this->scan_();
+        this->entry_ = nullptr;
+        this->frame_ = nullptr;
+        this->blob_ = nullptr;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @return the number of bytes required to encode an error.
+ */
+[[nodiscard]] inline std::size_t encoded_size(
+  const error_t& error, std::optional<std::int64_t> code = std::nullopt) {
+    return detail::encoding_t{ error.string(), code }.size();
+}
+
+/**
+ * @brief Encode an error into a caller-supplied buffer. Use encoded_size() to
+ * determine the required capacity.
+ *
+ * @param[in] error - The error to encode.
+ * @param[out] buffer - The destination for the encoded bytes.
+ * @param[in] capacity - The number of bytes available in the buffer.
+ * @param[in] code - An optional error code stored alongside the error.
+ * @return the number of bytes written or an error if the buffer is too small.
+ */
+[[nodiscard]] inline optional_t<std::size_t> encode(const error_t& error,
+  void* buffer,
+  std::size_t capacity,
+  std::optional<std::int64_t> code = std::nullopt) {
+    detail::encoding_t encoding{ error.string(), code };
+    if (! encoding.representable()) {
+        return RES_NEW_ERROR("The error is too large to encode.");
+    }
+
+    const std::size_t size = encoding.size();
+    if (size > capacity) {
+        return RES_NEW_ERROR("The buffer is too small to encode the error ("
+          + std::to_string(size) + " bytes required, "
+          + std::to_string(capacity) + " bytes available).");
+    }
+
+    encoding.write(static_cast<unsigned char*>(buffer));
+    return size;
+}
+
+/**
+ * @brief A read-only view of an encoded error. Frames are decoded on demand
+ * directly from the encoded bytes, which must outlive this object. Reading and
+ * accessing a view never allocates.
+ */
+class error_view_t {
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::uint32_t flags_ = 0;
+    std::int64_t code_ = 0;
+    std::uint32_t string_count_ = 0;
+    std::uint32_t frame_count_ = 0;
+
+    [[nodiscard]] const unsigned char* strings_() const {
+        return this->data_ + detail::encoding_header_size;
+    }
+
+    [[nodiscard]] const unsigned char* frames_() const {
+        return this->strings_()
+          + (std::size_t{ this->string_count_ } * detail::encoding_string_size);
+    }
+
+    [[nodiscard]] const unsigned char* blob_() const {
+        return this->frames_()
+          + (std::size_t{ this->frame_count_ } * detail::encoding_frame_size);
+    }
+
+    [[nodiscard]] std::string_view string_(std::uint32_t index) const {
+        const unsigned char* entry = this->strings_()
+          + (std::size_t{ index } * detail::encoding_string_size);
+        return std::string_view{
+            reinterpret_cast<const char*>(this->blob_())
+              + detail::load_u32(entry),
+            detail::load_u32(entry + 4),
+        };
+    }
+
+  public:
+    /**
+     * @brief Iterates over the frames of an encoded error.
+     */
+    class iterator_t {
+        const error_view_t* view_ = nullptr;
+        std::size_t index_ = 0;
+
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = frame_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = frame_t;
+
+        iterator_t() = default;
+        iterator_t(const error_view_t* view, std::size_t index)
+        : view_(view), index_(index) {
+        }
+
+        [[nodiscard]] frame_t operator*() const {
+            return this->view_->frame(this->index_);
+        }
+
+        iterator_t& operator++() {
+            ++this->index_;
+            return *this;
+        }
+
+        iterator_t operator++(int) {
+            iterator_t copy = *this;
+            ++this->index_;
+            return copy;
+        }
+
+        [[nodiscard]] bool operator==(const iterator_t& other) const {
+            return this->index_ == other.index_;
+        }
+
+        [[nodiscard]] bool operator!=(const iterator_t& other) const {
+            return this->index_ != other.index_;
+        }
+    };
+
+    // Default construction creates an empty view with no frames.
+    error_view_t() = default;
+
+    /**
+     * @brief Validate an encoded error and point this view at it. The view is
+     * left empty if the bytes are not a valid encoding.
+     *
+     * @param[in] data - The encoded bytes.
+     * @param[in] size - The number of bytes available. Bytes following the
+     * encoded error are ignored.
+     */
+    [[nodiscard]] result_t read(const void* data, std::size_t size) {
+        *this = error_view_t{};
+
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        if (bytes == nullptr || size < detail::encoding_header_size) {
+            return RES_NEW_ERROR("The encoded error is truncated.");
+        }
+        if (std::memcmp(bytes, detail::encoding_magic,
+              sizeof(detail::encoding_magic))
+          != 0) {
+            return RES_NEW_ERROR("The encoded error has an invalid header.");
+        }
+        if (bytes[3] != encoding_version) {
+            return RES_NEW_ERROR("Unsupported error encoding version "
+              + std::to_string(bytes[3]) + ".");
+        }
+
+        const std::uint32_t flags = detail::load_u32(bytes + 4);
+        const auto code =
+          static_cast<std::int64_t>(detail::load_u64(bytes + 8));
+        const std::uint32_t string_count = detail::load_u32(bytes + 16);
+        const std::uint32_t frame_count = detail::load_u32(bytes + 20);
+        const std::uint32_t blob_size = detail::load_u32(bytes + 24);
+        if ((flags & ~detail::encoding_flags) != 0
+          || detail::load_u32(bytes + 28) != 0) {
+            return RES_NEW_ERROR("The encoded error has an invalid header.");
+        }
+
+        // Sizes are computed in 64 bits so corrupt counts cannot overflow.
+        const std::uint64_t total = detail::encoding_header_size
+          + (std::uint64_t{ string_count } * detail::encoding_string_size)
+          + (std::uint64_t{ frame_count } * detail::encoding_frame_size)
+          + blob_size;
+        if (total > size) {
+            return RES_NEW_ERROR("The encoded error is truncated.");
+        }
+
+        const unsigned char* entry = bytes + detail::encoding_header_size;
+        for (std::uint32_t index = 0; index < string_count; ++index) {
+            const std::uint64_t offset = detail::load_u32(entry);
+            const std::uint64_t length = detail::load_u32(entry + 4);
+            if (offset + length > blob_size) {
+                return RES_NEW_ERROR(
+                  "The encoded error has an invalid string.");
+            }
+            entry += detail::encoding_string_size;
+        }
+
+        const unsigned char* frame = entry;
+        for (std::uint32_t index = 0; index < frame_count; ++index) {
+            const auto kind =
+              static_cast<detail::frame_kind_t>(detail::load_u32(frame));
+            const bool has_site = kind == detail::frame_kind_t::site
+              || kind == detail::frame_kind_t::site_message;
+            const bool has_message = kind == detail::frame_kind_t::text
+              || kind == detail::frame_kind_t::site_message;
+            if (! has_site && ! has_message) {
+                return RES_NEW_ERROR("The encoded error has an invalid frame.");
+            }
+            if (has_site
+              && (detail::load_u32(frame + 4) >= string_count
+                || detail::load_u32(frame + 8) >= string_count)) {
+                return RES_NEW_ERROR("The encoded error has an invalid frame.");
+            }
+            if (has_message && detail::load_u32(frame + 16) >= string_count) {
+                return RES_NEW_ERROR("The encoded error has an invalid frame.");
+            }
+            frame += detail::encoding_frame_size;
+        }
+
+        this->data_ = bytes;
+        this->size_ = static_cast<std::size_t>(total);
+        this->flags_ = flags;
+        this->code_ = code;
+        this->string_count_ = string_count;
+        this->frame_count_ = frame_count;
+        return success;
+    }
+
+    /**
+     * @return the number of bytes occupied by the encoded error.
+     */
+    [[nodiscard]] std::size_t size() const {
+        return this->size_;
+    }
+
+    /**
+     * @return true if an error code was encoded and false otherwise.
+     */
+    [[nodiscard]] bool has_code() const {
+        return (this->flags_ & detail::encoding_flag_code) != 0;
+    }
+
+    /**
+     * @return the encoded error code or zero if no code was encoded.
+     */
+    [[nodiscard]] std::int64_t code() const {
+        return this->code_;
+    }
+
+    /**
+     * @return the number of frames in the encoded error.
+     */
+    [[nodiscard]] std::size_t frame_count() const {
+        return this->frame_count_;
+    }
+
+    /**
+     * @brief Decode a single frame. The index must be less than frame_count().
+     */
+    [[nodiscard]] frame_t frame(std::size_t index) const {
+        const unsigned char* record =
+          this->frames_() + (index * detail::encoding_frame_size);
+        const auto kind = static_cast<detail::frame_kind_t>(
+          detail::load_u32(record));
+
+        frame_t frame;
+        if (kind != detail::frame_kind_t::text) {
+            frame.has_site = true;
+            frame.file = this->string_(detail::load_u32(record + 4));
+            frame.function = this->string_(detail::load_u32(record + 8));
+            frame.line = detail::load_u32(record + 12);
+        }
+        if (kind != detail::frame_kind_t::site) {
+            frame.has_message = true;
+            frame.message = this->string_(detail::load_u32(record + 16));
+        }
+        return frame;
+    }
+
+    [[nodiscard]] iterator_t begin() const {
+        return iterator_t{ this, 0 };
+    }
+
+    [[nodiscard]] iterator_t end() const {
+        return iterator_t{ this, this->frame_count_ };
+    }
+
+    /**
+     * @brief Render the encoded error exactly as error_t::string() rendered it
+     * before encoding.
+     */
+    [[nodiscard]] std::string string() const {
+        std::string output;
+        for (std::size_t index = 0; index < this->frame_count_; ++index) {
+            if (index > 0) {
+                output.push_back('\n');
+            }
+            render_frame(output, this->frame(index));
+        }
+        if ((this->flags_ & detail::encoding_flag_newline) != 0) {
+            output.push_back('\n');
+        }
+        return output;
+    }
+
+    /**
+     * @brief Copy the encoded error into a new error object.
+     */
+    [[nodiscard]] error_t to_error() const {
+        return error_t{ this->string() };
+    }
+};
+
+inline std::ostream& operator<<(
+  std::ostream& ostream, const error_view_t& error) {
+    return (ostream << error.string());
+}
+
+} // namespace res
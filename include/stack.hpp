@@ -0,0 +1,317 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file stack.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief Opt-in native stack capture for new errors with deferred, cached
+ * symbolization.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// POSIX includes
+#include <dlfcn.h>
+#include <pthread.h>
+
+// Compiler runtime includes
+#include <cxxabi.h>
+#include <unwind.h>
+
+// Local includes
+#include "error.hpp"
+
+namespace res {
+
+/**
+ * @brief The maximum number of return addresses captured for a single error.
+ */
+constexpr inline std::size_t max_stack_depth = 32;
+
+/**
+ * @brief How the native call stack is walked.
+ *
+ * unwind uses _Unwind_Backtrace, which works in any build but consults the
+ * unwind tables for every frame.
+ *
+ * frame_pointers follows the chain of saved frame pointers. It is much
+ * cheaper, but every function on the stack must be compiled with
+ * -fno-omit-frame-pointer. The walk stops at the first frame pointer outside
+ * of the stack of the calling thread, so functions without frame pointers
+ * truncate the stack and may add a bogus frame. Stacks that are not the
+ * thread's own (for example, those of stackful coroutines) are not walked.
+ * Only supported on x86-64 and AArch64 with glibc. Elsewhere, unwind is used
+ * instead.
+ */
+enum class stack_walk_t {
+    unwind,
+    frame_pointers,
+};
+
+namespace detail {
+
+#if defined(__GLIBC__) && (defined(__x86_64__) || defined(__aarch64__))
+constexpr inline bool frame_pointer_walk_supported = true;
+#else
+constexpr inline bool frame_pointer_walk_supported = false;
+#endif
+
+struct unwind_state_t {
+    std::uintptr_t* frames;
+    std::size_t size;
+    std::size_t skip;
+};
+
+inline _Unwind_Reason_Code unwind_frame(
+  _Unwind_Context* context, void* argument) {
+    auto& state = *static_cast<unwind_state_t*>(argument);
+    if (state.skip > 0) {
+        --state.skip;
+        return _URC_NO_REASON;
+    }
+    if (state.size == max_stack_depth) {
+        return _URC_END_OF_STACK;
+    }
+
+    const std::uintptr_t address = _Unwind_GetIP(context);
+    if (address == 0) {
+        return _URC_END_OF_STACK;
+    }
+    state.frames[state.size++] = address;
+    return _URC_NO_REASON;
+}
+
+/**
+ * @brief Capture the return addresses of the calling frames without
+ * symbolizing them. The first frame is new_error unless it was inlined.
+ */
+[[gnu::noinline]] inline void capture_stack(error_t& error) {
+    std::uintptr_t frames[max_stack_depth];
+    // Skip this function.
+    unwind_state_t state{ frames, 0, 1 };
+    _Unwind_Backtrace(unwind_frame, &state);
+    error.set_stack(std::vector<std::uintptr_t>(frames, frames + state.size));
+}
+
+struct stack_bounds_t {
+    std::uintptr_t low = 0;
+    std::uintptr_t high = 0;
+};
+
+/**
+ * @return the bounds of the stack of the calling thread or empty bounds if
+ * they cannot be determined.
+ */
+inline stack_bounds_t current_stack_bounds() {
+    stack_bounds_t bounds;
+#if defined(__GLIBC__)
+    pthread_attr_t attributes;
+    if (pthread_getattr_np(pthread_self(), &attributes) != 0) {
+        return bounds;
+    }
+    void* address = nullptr;
+    std::size_t size = 0;
+    if (pthread_attr_getstack(&attributes, &address, &size) == 0) {
+        bounds.low = reinterpret_cast<std::uintptr_t>(address);
+        bounds.high = bounds.low + size;
+    }
+    pthread_attr_destroy(&attributes);
+#endif
+    return bounds;
+}
+
+/**
+ * @brief Capture the return addresses of the calling frames by following saved
+ * frame pointers. Each frame record holds the caller's frame pointer followed
+ * by the return address, and records lie at increasing addresses towards the
+ * base of the stack. The first frame is new_error unless it was inlined.
+ * Functions without frame pointers leave other data where a record is
+ * expected, so the walk may read stack memory that AddressSanitizer considers
+ * out of scope. It is not instrumented for that reason.
+ */
+[[gnu::noinline, gnu::no_sanitize_address]] inline void capture_frame_pointers(
+  error_t& error) {
+    // Looking up the bounds is slow, so it is done once per thread.
+    thread_local const stack_bounds_t bounds = current_stack_bounds();
+    constexpr std::uintptr_t record_size = 2 * sizeof(std::uintptr_t);
+
+    std::uintptr_t frames[max_stack_depth];
+    std::size_t size = 0;
+    // The record of this function holds the return address into its caller.
+    auto frame = reinterpret_cast<std::uintptr_t>(__builtin_frame_address(0));
+    while (size < max_stack_depth && frame >= bounds.low
+      && frame + record_size <= bounds.high
+      && frame % alignof(std::uintptr_t) == 0) {
+        const auto* record = reinterpret_cast<const std::uintptr_t*>(frame);
+        if (record[1] == 0) {
+            break;
+        }
+        frames[size++] = record[1];
+        if (record[0] <= frame) {
+            break;
+        }
+        frame = record[0];
+    }
+    error.set_stack(std::vector<std::uintptr_t>(frames, frames + size));
+}
+
+/**
+ * @brief Resolve an address to "function+0xoffset (module)" without caching.
+ * Functions missing from the dynamic symbol table (for example, those in
+ * executables not linked with -rdynamic) are rendered relative to their
+ * module instead.
+ */
+inline std::string symbolize_uncached(std::uintptr_t address) {
+    // Return addresses point after the call, which may belong to the next
+    // function.
+    const std::uintptr_t call = address - 1;
+
+    Dl_info info{};
+    if (dladdr(reinterpret_cast<void*>(call), &info) == 0) {
+        return "???";
+    }
+
+    char offset[2 + (sizeof(std::uintptr_t) * 2) + 1];
+    std::string symbol;
+    if (info.dli_sname != nullptr) {
+        int status = -1;
+        char* demangled =
+          abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        symbol = (status == 0) ? demangled : info.dli_sname;
+        std::free(demangled);
+
+        std::snprintf(offset, sizeof(offset), "0x%zx",
+          static_cast<std::size_t>(
+            address - reinterpret_cast<std::uintptr_t>(info.dli_saddr)));
+    } else {
+        std::snprintf(offset, sizeof(offset), "0x%zx",
+          static_cast<std::size_t>(
+            address - reinterpret_cast<std::uintptr_t>(info.dli_fbase)));
+    }
+    symbol += '+';
+    symbol += offset;
+
+    if (info.dli_fname != nullptr) {
+        symbol += " (";
+        symbol += info.dli_fname;
+        symbol += ')';
+    }
+    return symbol;
+}
+
+struct symbol_cache_t {
+    std::mutex mutex;
+    std::unordered_map<std::uintptr_t, std::string> symbols;
+};
+
+inline symbol_cache_t& symbol_cache() {
+    static symbol_cache_t cache;
+    return cache;
+}
+
+} // namespace detail
+
+/**
+ * @brief Enable or disable capturing the native call stack of errors created
+ * with RES_NEW_ERROR. Disabled by default. While disabled, creating an error
+ * costs a single relaxed atomic load more than it otherwise would.
+ */
+inline void enable_stack_capture(
+  bool enable = true, stack_walk_t walk = stack_walk_t::unwind) {
+    detail::stack_capture_t capture = nullptr;
+    if (enable) {
+        capture = (walk == stack_walk_t::frame_pointers
+                    && detail::frame_pointer_walk_supported)
+          ? detail::capture_frame_pointers
+          : detail::capture_stack;
+    }
+    detail::stack_capture.store(capture, std::memory_order_relaxed);
+}
+
+/**
+ * @return true if stack capture is enabled and false otherwise.
+ */
+[[nodiscard]] inline bool stack_capture_enabled() {
+    return detail::stack_capture.load(std::memory_order_relaxed) != nullptr;
+}
+
+/**
+ * @brief Resolve a captured return address to a symbol. Results are cached for
+ * the lifetime of the process, so addresses within libraries that are later
+ * unloaded may resolve to stale symbols.
+ */
+[[nodiscard]] inline std::string symbolize(std::uintptr_t address) {
+    detail::symbol_cache_t& cache = detail::symbol_cache();
+    {
+        std::lock_guard<std::mutex> lock{ cache.mutex };
+        const auto found = cache.symbols.find(address);
+        if (found != cache.symbols.end()) {
+            return found->second;
+        }
+    }
+
+    // Symbolize outside of the lock since dladdr and demangling are slow.
+    std::string symbol = detail::symbolize_uncached(address);
+    std::lock_guard<std::mutex> lock{ cache.mutex };
+    return cache.symbols.emplace(address, std::move(symbol)).first->second;
+}
+
+/**
+ * @return the number of addresses in the process-wide symbol cache.
+ */
+[[nodiscard]] inline std::size_t symbol_cache_size() {
+    detail::symbol_cache_t& cache = detail::symbol_cache();
+    std::lock_guard<std::mutex> lock{ cache.mutex };
+    return cache.symbols.size();
+}
+
+/**
+ * @brief Render the stack captured by an error with one line per frame of the
+ * form "#index 0xaddress function+0xoffset (module)". The result is empty if
+ * no stack was captured.
+ */
+[[nodiscard]] inline std::string render_stack(const error_t& error) {
+    std::string rendered;
+    const std::vector<std::uintptr_t>& stack = error.stack();
+    for (std::size_t index = 0; index < stack.size(); ++index) {
+        char prefix[32 + (sizeof(std::uintptr_t) * 2)];
+        std::snprintf(prefix, sizeof(prefix), "#%zu 0x%zx ", index,
+          static_cast<std::size_t>(stack[index]));
+        rendered += prefix;
+        rendered += symbolize(stack[index]);
+        rendered += '\n';
+    }
+    return rendered;
+}
+
+} // namespace res
@@ -0,0 +1,232 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file static.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief Literal counterparts of optional_t and result_t for use in constant
+ * expressions.
+ * @date 2026-10-19
+ */
+
+// optional_t and result_t store their values and errors on the heap, so they
+// cannot be used in constant expressions. The types in this file store their
+// values inline and their error messages as string views (usually string
+// literals), so they are literal types. They convert to optional_t and
+// result_t at runtime.
+//
+// constexpr res::static_optional_t<int> parse_digit(char digit) {
+//     if (digit < '0' || digit > '9') {
+//         return res::static_error_t{ "not a digit" };
+//     }
+//     return digit - '0';
+// }
+//
+// static_assert(parse_digit('7').value() == 7);
+// static_assert(parse_digit('x').has_error());
+
+// Standard includes
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Local includes
+#include "error.hpp"
+#include "optional.hpp"
+#include "result.hpp"
+
+namespace res {
+
+/**
+ * @brief An error message that can be created in constant expressions. The
+ * message is not copied, so it must outlive this object.
+ */
+class static_error_t {
+    std::string_view message_;
+
+  public:
+    constexpr explicit static_error_t(std::string_view message)
+    : message_(message) {
+    }
+
+    /**
+     * @return the error message.
+     */
+    [[nodiscard]] constexpr std::string_view message() const {
+        return this->message_;
+    }
+
+    /**
+     * @return an error_t containing a copy of the error message.
+     */
+    [[nodiscard]] error_t to_error() const {
+        return error_t{ std::string{ this->message_ } };
+    }
+};
+
+/**
+ * @brief A literal counterpart of optional_t. Contains a value or an error
+ * message explaining why the value does not exist.
+ */
+template<typename type_t>
+class static_optional_t {
+    static_assert(std::is_trivially_copyable_v<type_t>
+        && std::is_trivially_destructible_v<type_t>,
+      "static_optional_t requires a trivially copyable value type.");
+
+    union {
+        char empty_;
+        type_t value_;
+    };
+    bool has_value_;
+    static_error_t error_;
+
+    static constexpr std::string_view has_value_message{ "Has value" };
+    static inline const std::string bad_optional_access_message{
+        "Attempted to access a value from a static_optional_t that does not "
+        "exist."
+    };
+
+  public:
+    using value_type = type_t;
+
+    // Initialize with an error.
+    constexpr static_optional_t(static_error_t error)
+    : empty_(), has_value_(false), error_(error) {
+    }
+
+    // Initialize with a value.
+    constexpr static_optional_t(const type_t& value)
+    : value_(value), has_value_(true), error_(has_value_message) {
+    }
+
+    /**
+     * @return true if this object contains a value and false otherwise.
+     */
+    [[nodiscard]] constexpr bool has_value() const {
+        return this->has_value_;
+    }
+
+    /**
+     * @throw bad_optional_access_t if this object does not contain a value.
+     * In a constant expression, this is a compile-time error instead.
+     * @return a reference to the value stored within this object.
+     */
+    [[nodiscard]] constexpr const type_t& value() const {
+        if (! this->has_value_) {
+            throw bad_optional_access_t{ RES_ERROR(
+              this->error_.to_error(), bad_optional_access_message) };
+        }
+        return this->value_;
+    }
+
+    /**
+     * @return true if this object contains an error and false otherwise.
+     */
+    [[nodiscard]] constexpr bool has_error() const {
+        return ! this->has_value_;
+    }
+
+    /**
+     * @return the error stored within this object or a generic success
+     * message if this object does not contain an error.
+     */
+    [[nodiscard]] constexpr static_error_t error() const {
+        return this->error_;
+    }
+
+    /**
+     * @return the value stored within this object or a default value if this
+     * object contains an error.
+     */
+    [[nodiscard]] constexpr type_t value_or(const type_t& value) const {
+        return this->has_value_ ? this->value_ : value;
+    }
+
+    /**
+     * @brief Convert to an optional_t, copying the error message.
+     */
+    operator optional_t<type_t>() const {
+        if (this->has_value_) {
+            return optional_t<type_t>{ this->value_ };
+        }
+        return optional_t<type_t>{ this->error_.to_error() };
+    }
+};
+
+/**
+ * @brief A literal counterpart of result_t. Indicates success or failure with
+ * an error message.
+ */
+class static_result_t {
+    bool success_;
+    static_error_t error_;
+
+    static constexpr std::string_view success_message{ "Success" };
+
+  public:
+    // Default construction indicates success.
+    constexpr static_result_t()
+    : success_(true), error_(success_message) {
+    }
+
+    // Initialize with an error.
+    constexpr static_result_t(static_error_t error)
+    : success_(false), error_(error) {
+    }
+
+    /**
+     * @return true if this result represents success and false otherwise.
+     */
+    [[nodiscard]] constexpr bool success() const {
+        return this->success_;
+    }
+
+    /**
+     * @return true if this result represents failure and false otherwise.
+     */
+    [[nodiscard]] constexpr bool failure() const {
+        return ! this->success_;
+    }
+
+    /**
+     * @return the error stored within this result or a generic success
+     * message if this result represents success.
+     */
+    [[nodiscard]] constexpr static_error_t error() const {
+        return this->error_;
+    }
+
+    /**
+     * @brief Convert to a result_t, copying the error message.
+     */
+    operator result_t() const {
+        if (this->success_) {
+            return result_t{};
+        }
+        return result_t{ this->error_.to_error() };
+    }
+};
+
+} // namespace res
@@ -0,0 +1,227 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file timeline.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief Opt-in timestamps for traces and export of error timelines in the
+ * Chrome trace event format.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Local includes
+#include "error.hpp"
+#include "result.hpp"
+
+namespace res {
+
+namespace detail {
+
+/**
+ * @return a small integer identifying the calling thread. Threads are numbered
+ * from 1 in the order in which they first record a frame.
+ */
+inline std::uint32_t thread_number() {
+    static std::atomic<std::uint32_t> next_thread{ 1 };
+    thread_local const std::uint32_t thread = next_thread.fetch_add(1);
+    return thread;
+}
+
+/**
+ * @brief Record the time at which a trace is appended. Uses the steady clock,
+ * which reads CLOCK_MONOTONIC through the vDSO on Linux.
+ */
+inline void record_frame(error_t& error, const site_t& site) {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    error.add_timed_frame(timed_frame_t{ site,
+      static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+      thread_number() });
+}
+
+/**
+ * @brief Append a string to a JSON document as a quoted and escaped string.
+ */
+inline void append_json_string(std::string& json, std::string_view text) {
+    json += '"';
+    for (const char character : text) {
+        switch (character) {
+            case '"':
+                json += "\\\"";
+                break;
+            case '\\':
+                json += "\\\\";
+                break;
+            case '\n':
+                json += "\\n";
+                break;
+            case '\r':
+                json += "\\r";
+                break;
+            case '\t':
+                json += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(character) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                      static_cast<unsigned int>(character));
+                    json += escaped;
+                } else {
+                    json += character;
+                }
+        }
+    }
+    json += '"';
+}
+
+/**
+ * @brief Append a duration in nanoseconds as fractional microseconds, the unit
+ * of timestamps in the Chrome trace event format.
+ */
+inline void append_microseconds(std::string& json, std::uint64_t nanoseconds) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03llu",
+      static_cast<unsigned long long>(nanoseconds / 1000),
+      static_cast<unsigned long long>(nanoseconds % 1000));
+    json += text;
+}
+
+} // namespace detail
+
+/**
+ * @brief Enable or disable recording when and on which thread each trace is
+ * appended to an error by RES_NEW_ERROR, RES_TRACE, RES_ERROR, and the
+ * combinators. Disabled by default. While disabled, appending a trace costs a
+ * single relaxed atomic load more than it otherwise would.
+ */
+inline void enable_frame_timing(bool enable = true) {
+    detail::frame_timer.store(
+      enable ? detail::record_frame : nullptr, std::memory_order_relaxed);
+}
+
+/**
+ * @return true if frame timing is enabled and false otherwise.
+ */
+[[nodiscard]] inline bool frame_timing_enabled() {
+    return detail::frame_timer.load(std::memory_order_relaxed) != nullptr;
+}
+
+/**
+ * @brief Render the timelines of errors in the Chrome trace event format, which
+ * Perfetto and chrome://tracing can display.
+ *
+ * Each error with a timeline is drawn as a slice named "error <index>" on the
+ * thread where it was created, spanning from its first to its last timed frame
+ * and carrying its full message. Every timed frame is drawn as an instant event
+ * named after its function on the thread that appended it. Timestamps are
+ * relative to the earliest frame of all errors.
+ */
+[[nodiscard]] inline std::string chrome_trace(
+  const std::vector<error_t>& errors) {
+    std::uint64_t origin = std::numeric_limits<std::uint64_t>::max();
+    for (const error_t& error : errors) {
+        for (const timed_frame_t& frame : error.timeline()) {
+            origin = std::min(origin, frame.timestamp);
+        }
+    }
+
+    std::string json = "{\"traceEvents\":[";
+    bool first_event = true;
+    const auto begin_event = [&json, &first_event]() {
+        json += first_event ? "\n" : ",\n";
+        first_event = false;
+    };
+
+    for (std::size_t index = 0; index < errors.size(); ++index) {
+        const std::vector<timed_frame_t>& timeline = errors[index].timeline();
+        if (timeline.empty()) {
+            continue;
+        }
+
+        const std::uint64_t begin = timeline.front().timestamp;
+        const std::uint64_t end = timeline.back().timestamp;
+        begin_event();
+        json += "{\"name\":\"error ";
+        json += std::to_string(index);
+        json += "\",\"cat\":\"res\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+        json += std::to_string(timeline.front().thread);
+        json += ",\"ts\":";
+        detail::append_microseconds(json, begin - origin);
+        json += ",\"dur\":";
+        detail::append_microseconds(json, end >= begin ? end - begin : 0);
+        json += ",\"args\":{\"message\":";
+        detail::append_json_string(json, errors[index].string());
+        json += "}}";
+
+        for (const timed_frame_t& frame : timeline) {
+            begin_event();
+            json += "{\"name\":";
+            detail::append_json_string(json, frame.site.function);
+            json += ",\"cat\":\"res\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,";
+            json += "\"tid\":";
+            json += std::to_string(frame.thread);
+            json += ",\"ts\":";
+            detail::append_microseconds(json, frame.timestamp - origin);
+            json += ",\"args\":{\"file\":";
+            detail::append_json_string(json, frame.site.file);
+            json += ",\"line\":";
+            json += std::to_string(frame.site.line);
+            json += ",\"error\":";
+            json += std::to_string(index);
+            json += "}}";
+        }
+    }
+
+    json += "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return json;
+}
+
+/**
+ * @brief Write the timelines of errors to a stream in the Chrome trace event
+ * format (see chrome_trace).
+ */
+[[nodiscard]] inline result_t write_chrome_trace(
+  std::ostream& ostream, const std::vector<error_t>& errors) {
+    const std::string json = chrome_trace(errors);
+    ostream.write(json.data(), static_cast<std::streamsize>(json.size()));
+    if (! ostream) {
+        return RES_NEW_ERROR("Failed to write the Chrome trace.");
+    }
+    return success;
+}
+
+} // namespace res
@@ -0,0 +1,203 @@
+#pragma once
+
+/*****************************************************************************/
+/*  Copyright (c) 2025 Caden Shmookler                                       */
+/*                                                                           */
+/*  This software is provided 'as-is', without any express or implied        */
+/*  warranty. In no event will the authors be held liable for any damages    */
+/*  arising from the use of this software.                                   */
+/*                                                                           */
+/*  Permission is granted to anyone to use this software for any purpose,    */
+/*  including commercial applications, and to alter it and redistribute it   */
+/*  freely, subject to the following restrictions:                           */
+/*                                                                           */
+/*  1. The origin of this software must not be misrepresented; you must not  */
+/*     claim that you wrote the original software. If you use this software  */
+/*     in a product, an acknowledgment in the product documentation would    */
+/*     be appreciated but is not required.                                   */
+/*  2. Altered source versions must be plainly marked as such, and must not  */
+/*     be misrepresented as being the original software.                     */
+/*  3. This notice may not be removed or altered from any source             */
+/*     distribution.                                                         */
+/*****************************************************************************/
+
+/**
+ * @file trace.hpp
+ * @author Caden Shmookler (cshmookler@gmail.com)
+ * @brief Utilities for parsing traces rendered by the error macros.
+ * @date 2026-10-19
+ */
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace res {
+
+/**
+ * @brief A single line of a rendered trace. Lines produced by RES_TRACE,
+ * RES_ERROR, and RES_NEW_ERROR have the form "file:function():line" with an
+ * optional " -> message" suffix. Any other line is stored verbatim in the
+ * message with no site information.
+ *
+ * All views refer to the parsed text, which must outlive this object.
+ */
+struct frame_t {
+    std::string_view file;
+    std::string_view function;
+    std::uint32_t line = 0;
+    std::string_view message;
+    bool has_site = false;
+    bool has_message = false;
+};
+
+namespace detail {
+
+constexpr inline std::string_view site_separator = "():";
+constexpr inline std::string_view message_separator = " -> ";
+
+/**
+ * @brief Parse a decimal line number exactly as std::to_string would render
+ * it (no sign and no leading zeros).
+ *
+ * @return true if the text is a valid line number and false otherwise.
+ */
+constexpr bool parse_line_number(std::string_view text, std::uint32_t& line) {
+    if (text.empty() || text.size() > 10) {
+        return false;
+    }
+    if (text.size() > 1 && text.front() == '0') {
+        return false;
+    }
+
+    std::uint64_t number = 0;
+    for (const char digit : text) {
+        if (digit < '0' || digit > '9') {
+            return false;
+        }
+        number = (number * 10) + static_cast<std::uint64_t>(digit - '0');
+    }
+    if (number > UINT32_MAX) {
+        return false;
+    }
+
+    line = static_cast<std::uint32_t>(number);
+    return true;
+}
+
+/**
+ * @brief Attempt to parse the site of a frame ending at the given occurrence of
+ * "():".
+ */
+constexpr bool parse_site(
+  std::string_view line, std::size_t separator, frame_t& frame) {
+    // The line number runs until the end of the line or the start of the
+    // message.
+    const std::size_t digits_begin = separator + site_separator.size();
+    std::size_t digits_end = digits_begin;
+    while (digits_end < line.size() && line[digits_end] >= '0'
+      && line[digits_end] <= '9') {
+        ++digits_end;
+    }
+
+    const std::string_view rest = line.substr(digits_end);
+    const bool has_message = ! rest.empty();
+    if (has_message && rest.substr(0, message_separator.size())
+      != message_separator) {
+        return false;
+    }
+
+    std::uint32_t line_number = 0;
+    if (! parse_line_number(
+          line.substr(digits_begin, digits_end - digits_begin), line_number)) {
+        return false;
+    }
+
+    // The file name ends at the first colon following the last path separator
+    // so that drive letters and qualified function names both survive.
+    const std::string_view site = line.substr(0, separator);
+    std::size_t name_begin = site.size();
+    while (name_begin > 0 && site[name_begin - 1] != '/'
+      && site[name_begin - 1] != '\\') {
+        --name_begin;
+    }
+    const std::size_t colon = site.find(':', name_begin);
+    if (colon == std::string_view::npos || colon == 0
+      || colon + 1 == site.size()) {
+        return false;
+    }
+
+    frame.file = site.substr(0, colon);
+    frame.function = site.substr(colon + 1);
+    frame.line = line_number;
+    frame.has_site = true;
+    frame.has_message = has_message;
+    frame.message =
+      has_message ? rest.substr(message_separator.size()) : std::string_view{};
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Parse a single line of a rendered trace. The line must not contain the
+ * terminating newline character.
+ */
+[[nodiscard]] constexpr frame_t parse_frame(std::string_view line) {
+    frame_t frame;
+
+    std::size_t separator = line.find(detail::site_separator);
+    while (separator != std::string_view::npos) {
+        if (detail::parse_site(line, separator, frame)) {
+            return frame;
+        }
+        separator = line.find(detail::site_separator, separator + 1);
+    }
+
+    frame.message = line;
+    frame.has_message = true;
+    return frame;
+}
+
+/**
+ * @brief Append a frame to a string in the same format used by the error
+ * macros. The terminating newline character is not appended.
+ */
+inline std::string& render_frame(std::string& output, const frame_t& frame) {
+    if (frame.has_site) {
+        output.append(frame.file);
+        output.push_back(':');
+        output.append(frame.function);
+        output.append(detail::site_separator);
+        output.append(std::to_string(frame.line));
+        if (frame.has_message) {
+            output.append(detail::message_separator);
+        }
+    }
+    if (frame.has_message) {
+        output.append(frame.message);
+    }
+    return output;
+}
+
+/**
+ * @brief Call a function with each line of a rendered trace. The terminating
+ * newline character of each line is not included, and a trailing newline does
+ * not produce an empty line at the end.
+ */
+template<typename callback_t>
+void for_each_line(std::string_view text, callback_t&& callback) {
+    while (! text.empty()) {
+        const std::size_t newline = text.find('\n');
+        if (newline == std::string_view::npos) {
+            callback(text);
+            return;
+        }
+        callback(text.substr(0, newline));
+        text.remove_prefix(newline + 1);
+    }
+}
+
+} // namespace res
@@ -0,0 +1,145 @@
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Local includes
+#include "../include/optional.hpp"
+#include "analyze.hpp"
+
+namespace {
+
+struct options_t {
+    std::size_t top = 10;
+    std::size_t threads = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<std::string> paths;
+};
+
+void print_usage(const char* program) {
+    std::cerr
+      << "Usage: " << program << " [-k count] [-j threads] <log>...\n"
+      << "Count rendered traces in log files by originating site, by frame "
+         "path, and by message.\n";
+}
+
+res::optional_t<options_t> parse_options(int argc, char** argv) {
+    options_t options;
+    for (int index = 1; index < argc; ++index) {
+        const std::string_view argument = argv[index];
+        if (argument == "-k" || argument == "-j") {
+            if (index + 1 == argc) {
+                return RES_NEW_ERROR(
+                  "Missing value for " + std::string{ argument } + ".");
+            }
+            std::size_t value = 0;
+            try {
+                value = std::stoul(argv[++index]);
+            } catch (const std::exception&) {
+                return RES_NEW_ERROR(
+                  "Invalid value for " + std::string{ argument } + ".");
+            }
+            (argument == "-k" ? options.top : options.threads) =
+              std::max<std::size_t>(value, 1);
+        } else {
+            options.paths.emplace_back(argument);
+        }
+    }
+    if (options.paths.empty()) {
+        return RES_NEW_ERROR("No log files given.");
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto options = parse_options(argc, argv);
+    if (options.has_error()) {
+        std::cerr << options.error();
+        print_usage(argv[0]);
+        return 2;
+    }
+    const options_t& config = options.value();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<analyzer::mapped_file_t> files;
+    std::vector<std::string_view> chunks;
+    std::uint64_t bytes = 0;
+    for (const std::string& path : config.paths) {
+        auto file = analyzer::map_file(path);
+        if (file.has_error()) {
+            std::cerr << file.error();
+            return 1;
+        }
+        files.push_back(std::move(file.value()));
+        const std::string_view text = files.back().text();
+        bytes += text.size();
+
+        // Several chunks per thread keep every core busy when traces are
+        // unevenly distributed.
+        for (const std::string_view chunk :
+          analyzer::split(text, config.threads * 4)) {
+            chunks.push_back(chunk);
+        }
+    }
+
+    std::vector<analyzer::counts_t> counts(
+      std::min(config.threads, chunks.size()));
+    std::atomic<std::size_t> next_chunk{ 0 };
+    std::vector<std::thread> workers;
+    for (analyzer::counts_t& worker_counts : counts) {
+        workers.emplace_back([&chunks, &next_chunk, &worker_counts]() {
+            for (std::size_t index = next_chunk.fetch_add(1);
+                 index < chunks.size();
+                 index = next_chunk.fetch_add(1)) {
+                analyzer::analyze(chunks[index], worker_counts);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    analyzer::counts_t total;
+    for (const analyzer::counts_t& worker_counts : counts) {
+        total.merge(worker_counts);
+    }
+
+    const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+    std::cout << "Traces: " << total.traces << " (" << total.lines
+              << " lines, " << bytes << " bytes) in " << std::fixed
+              << std::setprecision(3) << elapsed.count() << " s ("
+              << std::setprecision(1)
+              << (static_cast<double>(bytes) / 1e6 / elapsed.count())
+              << " MB/s)\n";
+
+    std::cout << "\nTop " << config.top << " originating sites:\n";
+    for (const auto& [site, count] : analyzer::top(total.sites, config.top)) {
+        std::cout << std::setw(12) << count << "  " << site << '\n';
+    }
+
+    std::cout << "\nTop " << config.top << " frame paths:\n";
+    for (const auto& [path, count] : analyzer::top(total.paths, config.top)) {
+        std::cout << std::setw(12) << count << "  "
+                  << analyzer::render_path(path.example) << '\n';
+    }
+
+    std::cout << "\nTop " << config.top << " messages:\n";
+    for (const auto& [message, count] :
+      analyzer::top(total.messages, config.top)) {
+        std::cout << std::setw(12) << count << "  " << message << '\n';
+    }
+
+    return 0;
+}
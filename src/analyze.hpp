@@ -0,0 +1,370 @@
+#pragma once
+
+// Standard includes
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// POSIX includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Local includes
+#include "../include/optional.hpp"
+#include "../include/trace.hpp"
+
+// Aggregates rendered traces found in log files. A trace is a run of
+// consecutive lines in the "file:function():line[ -> message]" format produced
+// by the error macros. The first line of a trace is its originating site.
+//
+// A trace ends at any line that is not a frame. Frames written by
+// RES_NEW_ERROR and RES_ERROR both carry a message and cannot be told apart,
+// so a frame with a message continues the trace as an annotation unless its
+// site already appears in the trace. Traces of the same error printed back to
+// back are therefore counted separately, while annotated traces are not split.
+
+namespace analyzer {
+
+/**
+ * @brief A read-only memory mapping of an entire file.
+ */
+class mapped_file_t {
+    void* mapping_ = nullptr;
+    std::size_t size_ = 0;
+
+  public:
+    mapped_file_t(void* mapping, std::size_t size)
+    : mapping_(mapping), size_(size) {
+    }
+
+    mapped_file_t(const mapped_file_t&) = delete;
+    mapped_file_t(mapped_file_t&& file) noexcept
+    : mapping_(std::exchange(file.mapping_, nullptr))
+    , size_(std::exchange(file.size_, 0)) {
+    }
+    mapped_file_t& operator=(const mapped_file_t&) = delete;
+    mapped_file_t& operator=(mapped_file_t&&) = delete;
+
+    ~mapped_file_t() {
+        if (this->mapping_ != nullptr) {
+            ::munmap(this->mapping_, this->size_);
+        }
+    }
+
+    [[nodiscard]] std::string_view text() const {
+        return { static_cast<const char*>(this->mapping_), this->size_ };
+    }
+};
+
+inline res::optional_t<mapped_file_t> map_file(const std::string& path) {
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return RES_NEW_ERROR("Failed to open \"" + path
+          + "\": " + std::strerror(errno));
+    }
+
+    struct stat status {};
+    if (::fstat(file, &status) != 0) {
+        const std::string message = std::strerror(errno);
+        ::close(file);
+        return RES_NEW_ERROR("Failed to read \"" + path + "\": " + message);
+    }
+
+    const auto size = static_cast<std::size_t>(status.st_size);
+    if (size == 0) {
+        ::close(file);
+        return mapped_file_t{ nullptr, 0 };
+    }
+
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    const std::string message = std::strerror(errno);
+    ::close(file);
+    if (mapping == MAP_FAILED) {
+        return RES_NEW_ERROR("Failed to map \"" + path + "\": " + message);
+    }
+
+    // Advice values are not flags, so each must be given separately.
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+    ::madvise(mapping, size, MADV_WILLNEED);
+
+    return mapped_file_t{ mapping, size };
+}
+
+/**
+ * @return the "file:function():line" prefix of a parsed frame.
+ */
+inline std::string_view site_of(
+  std::string_view line, const res::frame_t& frame) {
+    if (! frame.has_message) {
+        return line;
+    }
+    return line.substr(0, static_cast<std::size_t>(
+                            frame.message.data() - line.data())
+        - res::detail::message_separator.size());
+}
+
+inline std::uint64_t hash_combine(std::uint64_t hash, std::string_view site) {
+    // Order-dependent so paths with the same sites in a different order are
+    // counted separately.
+    const std::uint64_t site_hash = std::hash<std::string_view>{}(site);
+    return (hash ^ site_hash) * 0x9E3779B97F4A7C15ULL + (hash >> 29U);
+}
+
+/**
+ * @return true if two traces visit the same sites in the same order.
+ */
+inline bool same_path(std::string_view lhs, std::string_view rhs) {
+    while (! lhs.empty() && ! rhs.empty()) {
+        const std::size_t lhs_end = std::min(lhs.find('\n'), lhs.size());
+        const std::size_t rhs_end = std::min(rhs.find('\n'), rhs.size());
+        const std::string_view lhs_line = lhs.substr(0, lhs_end);
+        const std::string_view rhs_line = rhs.substr(0, rhs_end);
+        if (site_of(lhs_line, res::parse_frame(lhs_line))
+          != site_of(rhs_line, res::parse_frame(rhs_line))) {
+            return false;
+        }
+        lhs.remove_prefix(std::min(lhs_end + 1, lhs.size()));
+        rhs.remove_prefix(std::min(rhs_end + 1, rhs.size()));
+    }
+    return lhs.empty() && rhs.empty();
+}
+
+/**
+ * @brief A frame path identified by the hash of its sites. The first trace
+ * seen with the path is kept to compare against on a hash match and to print
+ * the path later.
+ */
+struct path_key_t {
+    std::uint64_t hash = 0;
+    std::string_view example;
+
+    [[nodiscard]] bool operator==(const path_key_t& other) const {
+        return this->hash == other.hash
+          && same_path(this->example, other.example);
+    }
+};
+
+struct path_hash_t {
+    [[nodiscard]] std::size_t operator()(const path_key_t& key) const {
+        return static_cast<std::size_t>(key.hash);
+    }
+};
+
+/**
+ * @brief Counts gathered by a single worker. Keys refer directly to the mapped
+ * files, so nothing is copied while parsing.
+ */
+struct counts_t {
+    std::uint64_t lines = 0;
+    std::uint64_t traces = 0;
+    std::unordered_map<std::string_view, std::uint64_t> sites;
+    std::unordered_map<std::string_view, std::uint64_t> messages;
+    std::unordered_map<path_key_t, std::uint64_t, path_hash_t> paths;
+
+    void merge(const counts_t& other) {
+        this->lines += other.lines;
+        this->traces += other.traces;
+        for (const auto& [site, count] : other.sites) {
+            this->sites[site] += count;
+        }
+        for (const auto& [message, count] : other.messages) {
+            this->messages[message] += count;
+        }
+        for (const auto& [path, count] : other.paths) {
+            this->paths[path] += count;
+        }
+    }
+};
+
+/**
+ * @return true if a frame that follows the frames of a trace begins a new
+ * trace instead of continuing it.
+ */
+inline bool begins_trace(const res::frame_t& frame, std::string_view site,
+  const std::vector<std::string_view>& trace_sites) {
+    return frame.has_message
+      && std::find(trace_sites.begin(), trace_sites.end(), site)
+      != trace_sites.end();
+}
+
+inline std::string_view line_at(std::string_view text, std::size_t begin) {
+    const std::size_t end = text.find('\n', begin);
+    return text.substr(
+      begin, (end == std::string_view::npos ? text.size() : end) - begin);
+}
+
+/**
+ * @return true if the line beginning at an offset continues the trace on the
+ * previous line rather than starting a new one.
+ */
+inline bool continues_trace(std::string_view text, std::size_t begin) {
+    if (begin == 0 || begin >= text.size()) {
+        return false;
+    }
+    const std::string_view line = line_at(text, begin);
+    const res::frame_t frame = res::parse_frame(line);
+    if (! frame.has_site) {
+        return false;
+    }
+
+    // Find the first frame of the run of frames preceding the line.
+    std::size_t first = begin;
+    while (first > 0) {
+        const std::size_t previous_newline =
+          (first >= 2) ? text.rfind('\n', first - 2) : std::string_view::npos;
+        const std::size_t previous =
+          (previous_newline == std::string_view::npos) ? 0
+                                                       : previous_newline + 1;
+        if (! res::parse_frame(line_at(text, previous)).has_site) {
+            break;
+        }
+        first = previous;
+    }
+    if (first == begin) {
+        return false;
+    }
+    if (! frame.has_message) {
+        return true;
+    }
+
+    // Replay the run to find the sites of the trace the line would continue.
+    std::vector<std::string_view> trace_sites;
+    for (std::size_t offset = first; offset < begin;
+         offset += line_at(text, offset).size() + 1) {
+        const std::string_view previous = line_at(text, offset);
+        const res::frame_t previous_frame = res::parse_frame(previous);
+        const std::string_view site = site_of(previous, previous_frame);
+        if (begins_trace(previous_frame, site, trace_sites)) {
+            trace_sites.clear();
+        }
+        trace_sites.push_back(site);
+    }
+    return ! begins_trace(frame, site_of(line, frame), trace_sites);
+}
+
+/**
+ * @brief Split text into chunks that begin on a line boundary outside of any
+ * trace, so each chunk can be parsed independently.
+ */
+inline std::vector<std::string_view> split(
+  std::string_view text, std::size_t count) {
+    std::vector<std::string_view> chunks;
+    std::size_t begin = 0;
+    for (std::size_t index = 1; index <= count && begin < text.size();
+         ++index) {
+        std::size_t end = (index == count)
+          ? text.size()
+          : std::max(begin, (text.size() / count) * index);
+
+        // Move to the start of the next line.
+        if (end < text.size() && end > 0 && text[end - 1] != '\n') {
+            const std::size_t newline = text.find('\n', end);
+            end =
+              (newline == std::string_view::npos) ? text.size() : newline + 1;
+        }
+
+        // Move past the remainder of a trace that spans the boundary.
+        while (continues_trace(text, end)) {
+            const std::size_t newline = text.find('\n', end);
+            end =
+              (newline == std::string_view::npos) ? text.size() : newline + 1;
+        }
+
+        if (end > begin) {
+            chunks.push_back(text.substr(begin, end - begin));
+        }
+        begin = end;
+    }
+    return chunks;
+}
+
+inline void analyze(std::string_view chunk, counts_t& counts) {
+    const char* trace_begin = nullptr;
+    const char* trace_end = nullptr;
+    std::uint64_t path_hash = 0;
+    std::vector<std::string_view> trace_sites;
+
+    const auto finish = [&]() {
+        if (trace_begin == nullptr) {
+            return;
+        }
+        ++counts.traces;
+        ++counts.paths[path_key_t{ path_hash,
+          std::string_view{ trace_begin,
+            static_cast<std::size_t>(trace_end - trace_begin) } }];
+        trace_begin = nullptr;
+    };
+
+    const char* cursor = chunk.data();
+    const char* const end = chunk.data() + chunk.size();
+    while (cursor < end) {
+        const auto* newline = static_cast<const char*>(
+          std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+        const char* line_end = (newline == nullptr) ? end : newline;
+        const std::string_view line{
+            cursor, static_cast<std::size_t>(line_end - cursor)
+        };
+        cursor = (newline == nullptr) ? end : newline + 1;
+        ++counts.lines;
+
+        const res::frame_t frame = res::parse_frame(line);
+        if (! frame.has_site) {
+            finish();
+            continue;
+        }
+
+        const std::string_view site = site_of(line, frame);
+        if (trace_begin != nullptr && begins_trace(frame, site, trace_sites)) {
+            finish();
+        }
+        if (trace_begin == nullptr) {
+            trace_begin = line.data();
+            path_hash = 0;
+            trace_sites.clear();
+            ++counts.sites[site];
+            if (frame.has_message) {
+                ++counts.messages[frame.message];
+            }
+        }
+        trace_sites.push_back(site);
+        trace_end = line_end;
+        path_hash = hash_combine(path_hash, site);
+    }
+    finish();
+}
+
+template<typename key_t, typename value_t, typename hash_t>
+std::vector<std::pair<key_t, value_t>> top(
+  const std::unordered_map<key_t, value_t, hash_t>& map, std::size_t count) {
+    std::vector<std::pair<key_t, value_t>> entries(map.begin(), map.end());
+    count = std::min(count, entries.size());
+    std::partial_sort(entries.begin(),
+      entries.begin() + static_cast<std::ptrdiff_t>(count),
+      entries.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+    entries.resize(count);
+    return entries;
+}
+
+inline std::string render_path(std::string_view trace) {
+    std::string path;
+    res::for_each_line(trace, [&path](std::string_view line) {
+        if (! path.empty()) {
+            path += " <- ";
+        }
+        path += site_of(line, res::parse_frame(line));
+    });
+    return path;
+}
+
+} // namespace analyzer
@@ -0,0 +1,70 @@
+// Standard includes
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+// Local includes
+#include "../include/journal.hpp"
+
+namespace {
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " <journal> [count]\n"
+              << "Print the most recent errors retained by a journal file, "
+                 "oldest first.\n";
+}
+
+std::string format_timestamp(std::int64_t timestamp) {
+    const auto seconds = static_cast<std::time_t>(timestamp / 1000000000);
+    const auto nanoseconds = timestamp % 1000000000;
+
+    std::tm time{};
+    gmtime_r(&seconds, &time);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &time);
+
+    std::string fraction = std::to_string(nanoseconds);
+    fraction.insert(0, 9 - fraction.size(), '0');
+    return std::string{ date } + "." + fraction + "Z";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::size_t count = SIZE_MAX;
+    if (argc == 3) {
+        try {
+            count = std::stoul(argv[2]);
+        } catch (const std::exception&) {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    auto entries = res::read_journal(argv[1]);
+    if (entries.has_error()) {
+        std::cerr << entries.error();
+        return 1;
+    }
+
+    const auto& all = entries.value();
+    const std::size_t first = all.size() > count ? all.size() - count : 0;
+    for (std::size_t index = first; index < all.size(); ++index) {
+        const res::journal_entry_t& entry = all[index];
+        std::cout << "[" << format_timestamp(entry.timestamp) << "] slot "
+                  << entry.slot << " #" << entry.sequence << '\n'
+                  << entry.error;
+        const std::string& string = entry.error.string();
+        if (string.empty() || string.back() != '\n') {
+            std::cout << '\n';
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+// Standard includes
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/analyze.hpp"
+
+namespace {
+
+// Several traces separated by other log lines, one printed back to back with
+// the next, and one created from a std::error_code.
+constexpr std::string_view log_text = "starting\n"
+                                      "a.cpp:parse():10 -> bad input\n"
+                                      "b.cpp:load():20\n"
+                                      "c.cpp:main():30\n"
+                                      "retrying\n"
+                                      "a.cpp:parse():10 -> bad input\n"
+                                      "b.cpp:load():20\n"
+                                      "c.cpp:main():30\n"
+                                      "a.cpp:parse():10 -> empty input\n"
+                                      "b.cpp:load():20\n"
+                                      "No such file [generic:2]\n"
+                                      "d.cpp:open():40\n"
+                                      "c.cpp:main():30\n"
+                                      "done\n";
+
+analyzer::counts_t analyze_chunks(std::string_view text, std::size_t count) {
+    analyzer::counts_t total;
+    for (const std::string_view chunk : analyzer::split(text, count)) {
+        analyzer::counts_t counts;
+        analyzer::analyze(chunk, counts);
+        total.merge(counts);
+    }
+    return total;
+}
+
+std::uint64_t path_count(
+  const analyzer::counts_t& counts, std::string_view path) {
+    for (const auto& [key, count] : counts.paths) {
+        if (analyzer::render_path(key.example) == path) {
+            return count;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+TEST(analyze_test, analyze) {
+    analyzer::counts_t counts;
+    analyzer::analyze(log_text, counts);
+
+    ASSERT_EQ(counts.lines, 14);
+    ASSERT_EQ(counts.traces, 4);
+    ASSERT_EQ(counts.sites.size(), 2);
+    ASSERT_EQ(counts.sites.at("a.cpp:parse():10"), 3);
+    ASSERT_EQ(counts.sites.at("d.cpp:open():40"), 1);
+    ASSERT_EQ(counts.messages.size(), 2);
+    ASSERT_EQ(counts.messages.at("bad input"), 2);
+    ASSERT_EQ(counts.messages.at("empty input"), 1);
+
+    ASSERT_EQ(counts.paths.size(), 3);
+    ASSERT_EQ(path_count(counts,
+                "a.cpp:parse():10 <- b.cpp:load():20 <- c.cpp:main():30"),
+      2);
+    ASSERT_EQ(path_count(counts, "a.cpp:parse():10 <- b.cpp:load():20"), 1);
+    ASSERT_EQ(path_count(counts, "d.cpp:open():40 <- c.cpp:main():30"), 1);
+}
+
+TEST(analyze_test, back_to_back_traces) {
+    analyzer::counts_t counts;
+    analyzer::analyze("a.cpp:f():1 -> first\n"
+                      "b.cpp:g():2\n"
+                      "a.cpp:f():1 -> second\n"
+                      "b.cpp:g():2\n",
+      counts);
+
+    ASSERT_EQ(counts.traces, 2);
+    ASSERT_EQ(counts.sites.at("a.cpp:f():1"), 2);
+    ASSERT_EQ(counts.messages.at("first"), 1);
+    ASSERT_EQ(counts.messages.at("second"), 1);
+    ASSERT_EQ(path_count(counts, "a.cpp:f():1 <- b.cpp:g():2"), 2);
+}
+
+TEST(analyze_test, annotated_trace) {
+    constexpr std::string_view text = "a.cpp:f():1 -> origin\n"
+                                      "b.cpp:g():2\n"
+                                      "c.cpp:h():3 -> annotated\n"
+                                      "d.cpp:main():4\n";
+    analyzer::counts_t counts;
+    analyzer::analyze(text, counts);
+
+    ASSERT_EQ(counts.traces, 1);
+    ASSERT_EQ(counts.sites.size(), 1);
+    ASSERT_EQ(counts.sites.at("a.cpp:f():1"), 1);
+    ASSERT_EQ(counts.messages.size(), 1);
+    ASSERT_EQ(counts.messages.at("origin"), 1);
+    ASSERT_EQ(path_count(counts,
+                "a.cpp:f():1 <- b.cpp:g():2 <- c.cpp:h():3 <- d.cpp:main():4"),
+      1);
+
+    // Chunks never begin at the annotated frame.
+    for (std::size_t count = 1; count <= text.size() + 1; ++count) {
+        ASSERT_EQ(analyze_chunks(text, count).traces, 1) << count;
+    }
+}
+
+TEST(analyze_test, split_covers_text) {
+    for (std::size_t count = 1; count <= log_text.size() + 1; ++count) {
+        const std::vector<std::string_view> chunks =
+          analyzer::split(log_text, count);
+        ASSERT_LE(chunks.size(), count);
+
+        std::string joined;
+        for (const std::string_view chunk : chunks) {
+            ASSERT_FALSE(chunk.empty());
+            joined += chunk;
+        }
+        ASSERT_EQ(joined, log_text) << count;
+    }
+}
+
+TEST(analyze_test, split_keeps_traces_whole) {
+    analyzer::counts_t expected;
+    analyzer::analyze(log_text, expected);
+
+    // Every chunk count places boundaries at different offsets, including
+    // within each trace.
+    for (std::size_t count = 1; count <= log_text.size() + 1; ++count) {
+        const analyzer::counts_t counts = analyze_chunks(log_text, count);
+        ASSERT_EQ(counts.lines, expected.lines) << count;
+        ASSERT_EQ(counts.traces, expected.traces) << count;
+        ASSERT_EQ(counts.sites, expected.sites) << count;
+        ASSERT_EQ(counts.messages, expected.messages) << count;
+        ASSERT_EQ(counts.paths.size(), expected.paths.size()) << count;
+    }
+}
+
+TEST(analyze_test, split_trace_straddling_boundary) {
+    // The midpoint of the text falls inside the trace.
+    const std::string text = std::string(40, '-') + "\n"
+      + "a.cpp:f():1 -> origin\n"
+      + "b.cpp:g():2\n"
+      + "c.cpp:h():3\n" + std::string(40, '-') + "\n";
+
+    const std::vector<std::string_view> chunks = analyzer::split(text, 2);
+    ASSERT_EQ(chunks.size(), 2);
+    ASSERT_NE(chunks[0].find("c.cpp:h():3"), std::string_view::npos);
+
+    const analyzer::counts_t counts = analyze_chunks(text, 2);
+    ASSERT_EQ(counts.traces, 1);
+    ASSERT_EQ(path_count(counts, "a.cpp:f():1 <- b.cpp:g():2 <- c.cpp:h():3"),
+      1);
+}
+
+TEST(analyze_test, paths_compare_text_on_hash_match) {
+    analyzer::counts_t counts;
+    ++counts.paths[analyzer::path_key_t{ 1, "a.cpp:f():1 -> x\nb.cpp:g():2" }];
+    ++counts.paths[analyzer::path_key_t{ 1, "a.cpp:f():1 -> y\nb.cpp:g():2" }];
+    ++counts.paths[analyzer::path_key_t{ 1, "c.cpp:h():3 -> x\nb.cpp:g():2" }];
+    ++counts.paths[analyzer::path_key_t{ 1, "a.cpp:f():1 -> x" }];
+
+    ASSERT_EQ(counts.paths.size(), 3);
+    ASSERT_EQ(path_count(counts, "a.cpp:f():1 <- b.cpp:g():2"), 2);
+    ASSERT_EQ(path_count(counts, "c.cpp:h():3 <- b.cpp:g():2"), 1);
+    ASSERT_EQ(path_count(counts, "a.cpp:f():1"), 1);
+}
+
+TEST(analyze_test, map_file) {
+    const auto path =
+      std::filesystem::temp_directory_path() / "cpp_result_analyze_map_file";
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(log_text.data(), 1, log_text.size(), file);
+    std::fclose(file);
+
+    auto mapped = analyzer::map_file(path.string());
+    ASSERT_TRUE(mapped.has_value());
+    ASSERT_EQ(mapped.value().text(), log_text);
+    std::filesystem::remove(path);
+
+    ASSERT_TRUE(analyzer::map_file(path.string()).has_error());
+}
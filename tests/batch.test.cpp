@@ -0,0 +1,170 @@
+// Standard includes
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/batch.hpp"
+
+TEST(batch_test, empty) {
+    const res::optional_batch_t<int> batch;
+    ASSERT_TRUE(batch.empty());
+    ASSERT_EQ(batch.size(), 0);
+    ASSERT_EQ(batch.count_errors(), 0);
+    ASSERT_EQ(batch.first_error(), 0);
+    ASSERT_EQ(batch.begin(), batch.end());
+}
+
+TEST(batch_test, push_back) {
+    res::optional_batch_t<std::string> batch;
+    batch.push_back(std::string{ "first" });
+    batch.push_back(res::error_t{ "error" });
+    batch.push_back(res::optional_t<std::string>{ "third" });
+    batch.push_back(res::optional_t<std::string>{ res::error_t{ "fourth" } });
+
+    ASSERT_EQ(batch.size(), 4);
+    ASSERT_TRUE(batch.has_value(0));
+    ASSERT_EQ(batch.value(0), "first");
+    ASSERT_TRUE(batch.has_error(1));
+    ASSERT_EQ(batch.error(1).string(), "error");
+    ASSERT_EQ(batch.value(2), "third");
+    ASSERT_EQ(batch.error(3).string(), "fourth");
+    ASSERT_EQ(batch.error(0).string(), "Has value");
+    ASSERT_THROW((void)batch.value(1), res::bad_optional_access_t);
+}
+
+TEST(batch_test, push_back_copies) {
+    const res::optional_t<std::string> value{ "value" };
+    const res::optional_t<std::string> error{ res::error_t{ "error" } };
+    res::optional_batch_t<std::string> batch;
+    batch.push_back(value);
+    batch.push_back(error);
+
+    ASSERT_EQ(batch.value(0), "value");
+    ASSERT_EQ(batch.error(1).string(), "error");
+    ASSERT_EQ(value.value(), "value");
+    ASSERT_EQ(error.error().string(), "error");
+
+    res::optional_t<bool> flag{ true };
+    res::optional_batch_t<bool> flags;
+    flags.push_back(flag);
+    ASSERT_TRUE(flags.value(0));
+}
+
+TEST(batch_test, bool_values) {
+    // std::vector<bool> has no addressable elements, so values are copied.
+    static_assert(std::is_same_v<decltype(std::declval<
+                                   const res::optional_batch_t<bool>&>()
+                                   .value(0)),
+      bool>);
+
+    res::optional_batch_t<bool> batch;
+    batch.push_back(true);
+    batch.push_back(res::optional_t<bool>{ res::error_t{ "error" } });
+    batch.push_back(res::optional_t<bool>{ false });
+
+    ASSERT_TRUE(batch.value(0));
+    ASSERT_TRUE(batch[0].value());
+    ASSERT_EQ(batch.error(1).string(), "error");
+    ASSERT_FALSE(batch.value(2));
+    ASSERT_FALSE(batch[2].value());
+}
+
+TEST(batch_test, count_errors) {
+    res::optional_batch_t<int> batch;
+    for (int index = 0; index < 1000; ++index) {
+        if (index % 7 == 3) {
+            batch.push_back(res::error_t{ std::to_string(index) });
+        } else {
+            batch.push_back(index);
+        }
+    }
+
+    // 1000 is not a multiple of the bitmap word size, so the last word is
+    // partially filled.
+    ASSERT_EQ(batch.count_errors(), 143);
+    ASSERT_EQ(batch.first_error(), 3);
+    ASSERT_EQ(batch.error(997).string(), "997");
+}
+
+TEST(batch_test, first_error) {
+    res::optional_batch_t<int> batch;
+    for (int index = 0; index < 200; ++index) {
+        batch.push_back(index);
+    }
+    ASSERT_EQ(batch.first_error(), 200);
+
+    batch.push_back(res::error_t{ "late" });
+    ASSERT_EQ(batch.first_error(), 200);
+    ASSERT_EQ(batch.count_errors(), 1);
+
+    batch.set(130, res::error_t{ "early" });
+    ASSERT_EQ(batch.first_error(), 130);
+    ASSERT_EQ(batch.count_errors(), 2);
+}
+
+TEST(batch_test, set) {
+    res::optional_batch_t<int> batch;
+    batch.push_back(1);
+    batch.push_back(res::error_t{ "error" });
+    batch.push_back(3);
+
+    batch.set(1, 2);
+    ASSERT_EQ(batch.value(1), 2);
+    ASSERT_EQ(batch.count_errors(), 0);
+
+    batch.set(2, res::error_t{ "second" });
+    batch.set(0, res::error_t{ "first" });
+    ASSERT_EQ(batch.error(0).string(), "first");
+    ASSERT_EQ(batch.error(2).string(), "second");
+
+    batch.set(2, res::error_t{ "replaced" });
+    ASSERT_EQ(batch.error(2).string(), "replaced");
+    ASSERT_EQ(batch.error(0).string(), "first");
+    ASSERT_EQ(batch.count_errors(), 2);
+}
+
+TEST(batch_test, iterate) {
+    res::optional_batch_t<int> batch;
+    batch.push_back(10);
+    batch.push_back(res::error_t{ "error" });
+    batch.push_back(30);
+
+    std::vector<std::size_t> indices;
+    int sum = 0;
+    for (const auto element : batch) {
+        indices.push_back(element.index());
+        if (element.has_value()) {
+            sum += element.value();
+        } else {
+            ASSERT_EQ(element.error().string(), "error");
+        }
+    }
+    ASSERT_EQ(indices, (std::vector<std::size_t>{ 0, 1, 2 }));
+    ASSERT_EQ(sum, 40);
+    ASSERT_TRUE(batch[1].has_error());
+}
+
+TEST(batch_test, values) {
+    res::optional_batch_t<int> batch;
+    batch.reserve(3);
+    batch.push_back(1);
+    batch.push_back(res::error_t{ "error" });
+    batch.push_back(3);
+    ASSERT_EQ(batch.values(), (std::vector<int>{ 1, 0, 3 }));
+}
+
+TEST(batch_test, clear) {
+    res::optional_batch_t<int> batch;
+    batch.push_back(res::error_t{ "error" });
+    batch.clear();
+    ASSERT_TRUE(batch.empty());
+    ASSERT_EQ(batch.count_errors(), 0);
+
+    batch.push_back(1);
+    ASSERT_EQ(batch.first_error(), 1);
+}
@@ -0,0 +1,223 @@
+// Standard includes
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// POSIX includes
+#include <elf.h>
+
+// Compares the code generated for the translation units in this directory
+// against the budgets in budgets.txt. Each budget may be exceeded by at most
+// budget_tolerance_percent percent.
+//
+// Usage: check <budgets> <compiler> <objdump> <count>
+//          <instantiations 1> <instantiations count>
+//          <expansions 1> <expansions count> <success path>
+//
+// The objdump path may be empty, in which case instruction counts are not
+// checked. Exits with 77 (skipped) if there are no budgets for the compiler.
+
+namespace {
+
+constexpr long budget_tolerance_percent = 10;
+constexpr int exit_skipped = 77;
+
+// Functions in success_path.cpp whose instruction counts are checked.
+constexpr const char* checked_functions[] = {
+    "has_value",
+    "value",
+    "propagate",
+    "combinators",
+};
+
+using sections_t = std::map<std::string, std::uint64_t>;
+
+// Read the sizes of all sections of a 64-bit ELF file.
+std::optional<sections_t> read_sections(const std::string& path) {
+    std::ifstream file{ path, std::ios::binary };
+    const std::vector<char> image{ std::istreambuf_iterator<char>{ file },
+        std::istreambuf_iterator<char>{} };
+    if (image.size() < sizeof(Elf64_Ehdr)
+      || std::memcmp(image.data(), ELFMAG, SELFMAG) != 0
+      || image[EI_CLASS] != ELFCLASS64) {
+        return std::nullopt;
+    }
+
+    Elf64_Ehdr header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    if (header.e_shoff + (header.e_shnum * sizeof(Elf64_Shdr))
+      > image.size()) {
+        return std::nullopt;
+    }
+
+    std::vector<Elf64_Shdr> headers(header.e_shnum);
+    std::memcpy(headers.data(), image.data() + header.e_shoff,
+      sizeof(Elf64_Shdr) * header.e_shnum);
+    const char* names = image.data() + headers[header.e_shstrndx].sh_offset;
+
+    sections_t sections;
+    for (const Elf64_Shdr& section : headers) {
+        sections[names + section.sh_name] = section.sh_size;
+    }
+    return sections;
+}
+
+// Count the instructions of a single function symbol with objdump.
+std::optional<long> count_instructions(const std::string& objdump,
+  const std::string& path, const std::string& symbol) {
+    const std::string command = "'" + objdump
+      + "' -d --no-show-raw-insn --disassemble=" + symbol + " '" + path + "'";
+    FILE* pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) {
+        return std::nullopt;
+    }
+
+    // Instruction lines begin with whitespace and a hexadecimal address
+    // followed by a colon.
+    long count = 0;
+    char line[512];
+    while (std::fgets(line, sizeof(line), pipe) != nullptr) {
+        const char* character = line;
+        while (*character == ' ' || *character == '\t') {
+            ++character;
+        }
+        if (character == line) {
+            continue;
+        }
+        const char* digits = character;
+        while (std::isxdigit(static_cast<unsigned char>(*character)) != 0) {
+            ++character;
+        }
+        if (character != digits && *character == ':') {
+            ++count;
+        }
+    }
+    if (pclose(pipe) != 0 || count == 0) {
+        return std::nullopt;
+    }
+    return count;
+}
+
+// Read the budgets for a compiler. Each line has the form
+// "<compiler> <metric> <budget>". Empty lines and lines beginning with '#'
+// are ignored.
+std::map<std::string, long> read_budgets(
+  const std::string& path, const std::string& compiler) {
+    std::map<std::string, long> budgets;
+    std::ifstream file{ path };
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        std::istringstream fields{ line };
+        std::string line_compiler;
+        std::string metric;
+        long budget = 0;
+        if ((fields >> line_compiler >> metric >> budget)
+          && line_compiler == compiler) {
+            budgets[metric] = budget;
+        }
+    }
+    return budgets;
+}
+
+// The growth per instantiation or expansion of a section, rounded up.
+long growth(const sections_t& single, const sections_t& many,
+  const std::string& section, long count) {
+    const auto size = [&section](const sections_t& sections) {
+        const auto found = sections.find(section);
+        return found == sections.end() ? 0L : static_cast<long>(found->second);
+    };
+    const long difference = size(many) - size(single);
+    return (difference + count - 2) / (count - 1);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 10) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <budgets> <compiler> <objdump> <count>"
+                     " <instantiations 1> <instantiations count>"
+                     " <expansions 1> <expansions count> <success path>\n";
+        return EXIT_FAILURE;
+    }
+    const std::string budgets_path = argv[1];
+    const std::string compiler = argv[2];
+    const std::string objdump = argv[3];
+    const long count = std::strtol(argv[4], nullptr, 10);
+    if (count < 2) {
+        std::cerr << "The count must be at least 2.\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::optional<sections_t>> modules;
+    for (int index = 5; index < 9; ++index) {
+        modules.push_back(read_sections(argv[index]));
+        if (! modules.back().has_value()) {
+            std::cerr << argv[index] << " is not a 64-bit ELF file.\n";
+            return exit_skipped;
+        }
+    }
+
+    std::map<std::string, long> measured;
+    for (const char* section : { ".text", ".eh_frame" }) {
+        const std::string name{ section + 1 };
+        measured["instantiation." + name] =
+          growth(*modules[0], *modules[1], section, count);
+        measured["expansion." + name] =
+          growth(*modules[2], *modules[3], section, count);
+    }
+    if (! objdump.empty()) {
+        for (const char* function : checked_functions) {
+            const std::optional<long> instructions = count_instructions(
+              objdump, argv[9], std::string{ "res_codegen_" } + function);
+            if (! instructions.has_value()) {
+                std::cerr << "Failed to disassemble " << function << ".\n";
+                return EXIT_FAILURE;
+            }
+            measured[std::string{ function } + ".instructions"] =
+              *instructions;
+        }
+    }
+
+    const std::map<std::string, long> budgets =
+      read_budgets(budgets_path, compiler);
+
+    bool failed = false;
+    for (const auto& [metric, value] : measured) {
+        const auto budget = budgets.find(metric);
+        std::cout << compiler << ' ' << metric << ' ' << value;
+        if (budget == budgets.end()) {
+            std::cout << " (no budget)\n";
+            continue;
+        }
+
+        const long limit =
+          budget->second + (budget->second * budget_tolerance_percent / 100);
+        std::cout << " (budget " << budget->second << ", limit " << limit
+                  << ")";
+        if (value > limit) {
+            std::cout << " EXCEEDED";
+            failed = true;
+        }
+        std::cout << '\n';
+    }
+
+    if (budgets.empty()) {
+        std::cout << "No budgets for " << compiler << ".\n";
+        return exit_skipped;
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
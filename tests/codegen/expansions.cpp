@@ -0,0 +1,47 @@
+// Standard includes
+#include <utility>
+
+// Local includes
+#include "../../include/optional.hpp"
+
+// Expands RES_NEW_ERROR, RES_TRACE, and RES_ERROR RES_CODEGEN_COUNT times. The
+// code size check compares builds with different counts to measure the
+// footprint of a single expansion of each macro.
+
+#ifndef RES_CODEGEN_COUNT
+#error "RES_CODEGEN_COUNT must be defined."
+#endif
+
+namespace {
+
+template<int index>
+[[gnu::noinline]] res::optional_t<int> expand(int input) {
+    if (input == index) {
+        return RES_NEW_ERROR("rejected");
+    }
+    if (input == -index) {
+        return RES_ERROR(res::error_t{ "inner" }, "annotated");
+    }
+    return input;
+}
+
+template<int index>
+[[gnu::noinline]] res::optional_t<int> propagate(int input) {
+    res::optional_t<int> result = expand<index>(input);
+    if (result.has_error()) {
+        return RES_TRACE(result.error());
+    }
+    return result.value() + index;
+}
+
+template<int... indices>
+int propagate_all(int input, std::integer_sequence<int, indices...>) {
+    return (propagate<indices>(input).has_value() + ...);
+}
+
+} // namespace
+
+extern "C" int res_codegen_expansions(int input) {
+    return propagate_all(
+      input, std::make_integer_sequence<int, RES_CODEGEN_COUNT>{});
+}
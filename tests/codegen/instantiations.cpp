@@ -0,0 +1,57 @@
+// Standard includes
+#include <string>
+#include <utility>
+
+// Local includes
+#include "../../include/optional.hpp"
+
+// Instantiates optional_t and its common operations for RES_CODEGEN_COUNT
+// distinct value types. The code size check compares builds with different
+// counts to measure the footprint of a single instantiation.
+
+#ifndef RES_CODEGEN_COUNT
+#error "RES_CODEGEN_COUNT must be defined."
+#endif
+
+namespace {
+
+template<int index>
+struct value_t {
+    int value;
+};
+
+template<int index>
+[[gnu::noinline]] res::optional_t<value_t<index>> make(int input) {
+    if (input == index) {
+        return RES_NEW_ERROR("rejected");
+    }
+    return value_t<index>{ input };
+}
+
+template<int index>
+[[gnu::noinline]] int exercise(int input) {
+    res::optional_t<value_t<index>> optional = make<index>(input);
+    const res::optional_t<value_t<index>> copy = optional;
+    if (copy.has_error()) {
+        return static_cast<int>(copy.error().string().size());
+    }
+
+    return std::move(optional)
+      .and_then([](value_t<index> value) -> res::optional_t<value_t<index>> {
+          return value_t<index>{ value.value + 1 };
+      })
+      .transform([](value_t<index> value) { return value.value * 2; })
+      .value();
+}
+
+template<int... indices>
+int exercise_all(int input, std::integer_sequence<int, indices...>) {
+    return (exercise<indices>(input) + ...);
+}
+
+} // namespace
+
+extern "C" int res_codegen_instantiations(int input) {
+    return exercise_all(
+      input, std::make_integer_sequence<int, RES_CODEGEN_COUNT>{});
+}
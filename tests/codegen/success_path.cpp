@@ -0,0 +1,54 @@
+// Standard includes
+#include <string>
+
+// Local includes
+#include "../../include/optional.hpp"
+
+// Small functions whose instruction counts are checked individually. Error
+// handling that GCC moves into a separate cold partition is not counted, so
+// the counts approximate the size of the success path.
+
+namespace {
+
+[[gnu::noinline]] res::optional_t<int> parse(int input) {
+    if (input < 0) {
+        return RES_NEW_ERROR("negative");
+    }
+    return input;
+}
+
+} // namespace
+
+extern "C" {
+
+bool res_codegen_has_value(const res::optional_t<int>& optional) {
+    return optional.has_value();
+}
+
+int res_codegen_value(const res::optional_t<int>& optional) {
+    return optional.value();
+}
+
+// Propagates errors manually with RES_TRACE.
+void res_codegen_propagate(int input, res::optional_t<int>& output) {
+    res::optional_t<int> first = parse(input);
+    if (first.has_error()) {
+        output = RES_TRACE(first.error());
+        return;
+    }
+    res::optional_t<int> second = parse(first.value() - 1);
+    if (second.has_error()) {
+        output = RES_TRACE(second.error());
+        return;
+    }
+    output = second.value() * 2;
+}
+
+// Propagates errors with the combinators.
+void res_codegen_combinators(int input, res::optional_t<int>& output) {
+    output = parse(input)
+               .and_then([](int value) { return parse(value - 1); }, RES_SITE)
+               .transform([](int value) { return value * 2; }, RES_SITE);
+}
+
+} // extern "C"
@@ -0,0 +1,277 @@
+// Standard includes
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/coroutine.hpp"
+
+#ifndef RES_HAS_COROUTINES
+#error "Coroutine tests require C++20 coroutine support."
+#endif
+
+namespace {
+
+res::optional_t<int> parse(int value) {
+    if (value < 0) {
+        return RES_NEW_ERROR("value cannot be negative");
+    }
+    return value;
+}
+
+res::result_t check(bool value) {
+    if (! value) {
+        return RES_NEW_ERROR("check failed");
+    }
+    return res::success;
+}
+
+res::optional_t<int> sum(int lhs, int rhs) {
+    const int left = co_await parse(lhs);
+    const int right = co_await parse(rhs);
+    co_return left + right;
+}
+
+res::optional_t<int> nested(int value) {
+    co_return (co_await sum(value, value)) + 1;
+}
+
+res::result_t validate(bool first, bool second) {
+    co_await check(first);
+    co_await check(second);
+    co_return res::success;
+}
+
+res::optional_t<int> from_result(bool value) {
+    co_await check(value);
+    co_return 1;
+}
+
+res::result_t from_optional(int value) {
+    co_await parse(value);
+    co_return res::success;
+}
+
+} // namespace
+
+TEST(coroutine_test, optional_value) {
+    auto result = sum(1, 2);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result.value(), 3);
+}
+
+TEST(coroutine_test, optional_error) {
+    auto result = sum(1, -2);
+    ASSERT_TRUE(result.has_error());
+
+    // The error from parse() has a trace for the co_await expression in sum().
+    const std::string expected = parse(-2).error().string();
+    const std::string actual = result.error().string();
+    ASSERT_GT(actual.size(), expected.size());
+    ASSERT_NE(actual.find(":sum():"), std::string::npos);
+}
+
+TEST(coroutine_test, optional_short_circuits) {
+    int calls = 0;
+    auto counted = [&calls](int value) -> res::optional_t<int> {
+        ++calls;
+        co_return co_await parse(value);
+    };
+    auto first = [&counted]() -> res::optional_t<int> {
+        co_await counted(-1);
+        co_await counted(1);
+        co_return 0;
+    };
+    ASSERT_TRUE(first().has_error());
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(coroutine_test, optional_nested) {
+    ASSERT_EQ(nested(2).value(), 5);
+
+    auto result = nested(-1);
+    ASSERT_TRUE(result.has_error());
+    ASSERT_NE(result.error().string().find(":nested():"), std::string::npos);
+    ASSERT_NE(result.error().string().find(":sum():"), std::string::npos);
+}
+
+TEST(coroutine_test, optional_co_return_error) {
+    auto coroutine = []() -> res::optional_t<int> {
+        co_await parse(1);
+        co_return RES_NEW_ERROR("returned");
+    };
+    auto result = coroutine();
+    ASSERT_TRUE(result.has_error());
+    ASSERT_NE(result.error().string().find("returned"), std::string::npos);
+}
+
+TEST(coroutine_test, optional_lvalue) {
+    auto coroutine = [](res::optional_t<std::string>& value)
+      -> res::optional_t<size_t> {
+        std::string& string = co_await value;
+        string += "!";
+        co_return string.size();
+    };
+
+    res::optional_t<std::string> value{ std::string{ "value" } };
+    ASSERT_EQ(coroutine(value).value(), 6);
+    ASSERT_EQ(value.value(), "value!");
+
+    res::optional_t<std::string> error{ res::error_t{ "error" } };
+    ASSERT_TRUE(coroutine(error).has_error());
+    ASSERT_TRUE(error.has_error());
+}
+
+TEST(coroutine_test, optional_move_only) {
+    auto coroutine = []() -> res::optional_t<std::unique_ptr<int>> {
+        std::unique_ptr<int> value =
+          co_await res::optional_t<std::unique_ptr<int>>{
+              std::make_unique<int>(4)
+          };
+        co_return std::move(value);
+    };
+    ASSERT_EQ(*(coroutine().value()), 4);
+}
+
+TEST(coroutine_test, optional_temporary_range) {
+    auto make_vector = []() -> res::optional_t<std::vector<int>> {
+        return std::vector<int>{ 1, 2, 3 };
+    };
+    auto coroutine = [&make_vector]() -> res::optional_t<int> {
+        // The awaited temporary is destroyed before the loop body runs.
+        int total = 0;
+        for (const int value : co_await make_vector()) {
+            total += value;
+        }
+        auto&& bound = co_await make_vector();
+        co_return total + static_cast<int>(bound.size());
+    };
+    ASSERT_EQ(coroutine().value(), 9);
+}
+
+TEST(coroutine_test, result) {
+    ASSERT_TRUE(validate(true, true).success());
+
+    auto result = validate(true, false);
+    ASSERT_TRUE(result.failure());
+    ASSERT_NE(result.error().string().find(":validate():"), std::string::npos);
+}
+
+TEST(coroutine_test, mixed) {
+    ASSERT_EQ(from_result(true).value(), 1);
+    ASSERT_TRUE(from_result(false).has_error());
+    ASSERT_TRUE(from_optional(1).success());
+    ASSERT_TRUE(from_optional(-1).failure());
+}
+
+TEST(coroutine_test, exception) {
+    auto coroutine = []() -> res::optional_t<int> {
+        co_await parse(1);
+        throw std::runtime_error{ "thrown" };
+    };
+    ASSERT_THROW((void)coroutine(), std::runtime_error);
+}
+
+TEST(coroutine_test, many_calls) {
+    // Frames are recycled, so repeated calls must not interfere.
+    for (int index = 0; index < 1000; ++index) {
+        ASSERT_EQ(sum(index, index).value(), 2 * index);
+        ASSERT_TRUE(sum(index, -1).has_error());
+    }
+}
+
+TEST(coroutine_test, reference_and_void) {
+    auto coroutine = [](res::optional_t<std::string&> reference,
+                       res::optional_t<void> check) -> res::optional_t<size_t> {
+        co_await std::move(check);
+        std::string& string = co_await std::move(reference);
+        string += "!";
+        co_return string.size();
+    };
+
+    std::string value{ "value" };
+    ASSERT_EQ(coroutine(value, {}).value(), 6);
+    ASSERT_EQ(value, "value!");
+
+    ASSERT_TRUE(coroutine(value, res::error_t{ "" }).has_error());
+    ASSERT_EQ(value, "value!");
+}
+
+TEST(coroutine_test, const_lvalue) {
+    auto coroutine = [](const res::optional_t<std::string>& value,
+                       const res::result_t& check) -> res::optional_t<size_t> {
+        co_await check;
+        const std::string& string = co_await value;
+        co_return string.size();
+    };
+
+    const res::optional_t<std::string> value{ std::string{ "value" } };
+    ASSERT_EQ(coroutine(value, res::success).value(), 5);
+
+    const res::optional_t<std::string> error{ res::error_t{ "error" } };
+    ASSERT_TRUE(coroutine(error, res::success).has_error());
+    ASSERT_TRUE(error.has_error());
+
+    const res::result_t failure{ res::error_t{ "failure" } };
+    ASSERT_TRUE(coroutine(value, failure).has_error());
+    ASSERT_TRUE(failure.failure());
+}
+
+#if defined(__cpp_lib_source_location)
+
+namespace {
+
+struct callable_t {
+    res::optional_t<int> operator()(int value) const {
+        co_return co_await parse(value);
+    }
+};
+
+template<typename type_t>
+res::optional_t<type_t> templated(type_t value) {
+    co_return co_await parse(value);
+}
+
+} // namespace
+
+TEST(coroutine_test, function_name) {
+    using res::detail::function_name;
+    ASSERT_EQ(function_name("int main()"), "main");
+    ASSERT_EQ(function_name("res::optional_t<int> ns::sum(int, int)"), "sum");
+    ASSERT_EQ(function_name("T ns::f(T) [with T = int]"), "f");
+    ASSERT_EQ(function_name("main()::<lambda(int)>"), "operator()");
+    ASSERT_EQ(
+      function_name("main()::<lambda(auto:1)> [with auto:1 = int]"),
+      "operator()");
+    ASSERT_EQ(function_name("auto main()::(anonymous class)::operator()(int) "
+                            "const"),
+      "operator()");
+    ASSERT_EQ(function_name("void foo_t::operator()(int) const"), "operator()");
+    ASSERT_EQ(
+      function_name("bool foo_t::operator<(const foo_t&) const"), "operator<");
+    ASSERT_EQ(
+      function_name("bool foo_t::operator>(const foo_t&) const"), "operator>");
+    ASSERT_EQ(function_name("foo_t::operator int() const"), "operator int");
+    ASSERT_EQ(function_name("void operator_t::run() &&"), "run");
+    ASSERT_EQ(function_name("class res::optional_t<int> __cdecl sum(int)"),
+      "sum");
+}
+
+TEST(coroutine_test, site_matches_function) {
+    const std::string lambda = [](int value) -> res::optional_t<int> {
+        co_return co_await parse(value);
+    }(-1).error().string();
+    ASSERT_NE(lambda.find(":operator()():"), std::string::npos) << lambda;
+
+    const std::string member = callable_t{}(-1).error().string();
+    ASSERT_NE(member.find(":operator()():"), std::string::npos) << member;
+
+    const std::string function = templated(-1).error().string();
+    ASSERT_NE(function.find(":templated():"), std::string::npos) << function;
+}
+
+#endif
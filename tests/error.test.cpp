@@ -1,3 +1,12 @@
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
 // External includes
 #include <gtest/gtest.h>
 
@@ -51,6 +60,29 @@ TEST(error_test, error_move_constructor) {
     ASSERT_GT(error.string().size(), 0);
 }
 
+TEST(error_test, metadata_out_of_line) {
+    // Codes, stacks, timelines and trace limits are stored behind a single
+    // pointer that stays null for plain errors.
+    static_assert(sizeof(res::error_t) == sizeof(std::string) + sizeof(void*));
+
+    const std::error_code code = std::make_error_code(std::errc::io_error);
+    res::error_t error{ code };
+    res::error_t copy{ error };
+    ASSERT_EQ(copy.code(), code);
+    ASSERT_EQ(copy.string(), error.string());
+
+    res::error_t moved{ std::move(copy) };
+    ASSERT_EQ(moved.code(), code);
+
+    res::error_t assigned{ "plain" };
+    ASSERT_FALSE(assigned.has_code());
+    assigned = error;
+    ASSERT_EQ(assigned.code(), code);
+    assigned = res::error_t{ "plain" };
+    ASSERT_FALSE(assigned.has_code());
+    ASSERT_EQ(assigned.string(), "plain");
+}
+
 TEST(error_test, error_string_const_reference) {
     std::string message = "This is an error message.";
     const res::error_t error{ message };
@@ -77,3 +109,283 @@ TEST(error_test, error_string_reference) {
     error.string() += "a";
     ASSERT_STREQ(message.c_str(), error.string().c_str());
 }
+
+TEST(error_test, res_trace_macro_format) {
+    const auto line = std::to_string(__LINE__ + 1);
+    const res::error_t error = RES_TRACE(res::error_t{ "message\n" });
+    ASSERT_EQ(error.string(),
+      std::string{ "message\n" } + __FILE__ + ":TestBody():" + line + "\n");
+}
+
+TEST(error_test, res_error_macro_format) {
+    const auto line = std::to_string(__LINE__ + 1);
+    const res::error_t error = RES_ERROR(res::error_t{ "" }, "message");
+    ASSERT_EQ(error.string(),
+      std::string{ __FILE__ } + ":TestBody():" + line + " -> message\n");
+}
+
+TEST(error_test, traced_with_string) {
+    const std::string message = "message";
+    const res::site_t site{ "file.cpp", "func", 1 };
+    ASSERT_EQ(res::traced(res::error_t{ "" }, site, message).string(),
+      res::traced(res::error_t{ "" }, site, message.c_str()).string());
+}
+
+TEST(error_test, trace_moves_error) {
+    res::error_t error{ std::string(100, 'x') };
+    error.string().reserve(1000);
+    const char* data = error.string().data();
+    const res::error_t traced = res::traced(std::move(error), RES_SITE);
+    ASSERT_EQ(traced.string().substr(0, 100), std::string(100, 'x'));
+    ASSERT_EQ(traced.string().data(), data);
+}
+
+TEST(error_test, append_trace_in_place) {
+    res::error_t error{ "" };
+    res::append_trace(error, res::site_t{ "file.cpp", "func", 7 }, "message");
+    res::append_trace(error, res::site_t{ "file.cpp", "caller", 9 });
+    ASSERT_EQ(error.string(),
+      "file.cpp:func():7 -> message\nfile.cpp:caller():9\n");
+}
+
+namespace {
+
+// Sets the trace limit for the lifetime of a test.
+struct trace_limit_guard_t {
+    explicit trace_limit_guard_t(res::trace_limit_t limit) {
+        res::set_trace_limit(limit);
+    }
+    ~trace_limit_guard_t() {
+        res::set_trace_limit(res::trace_limit_t{});
+    }
+    trace_limit_guard_t(const trace_limit_guard_t&) = delete;
+    trace_limit_guard_t& operator=(const trace_limit_guard_t&) = delete;
+};
+
+std::vector<std::string> lines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::size_t begin = 0;
+    for (std::size_t end = text.find('\n'); end != std::string::npos;
+      end = text.find('\n', begin)) {
+        lines.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return lines;
+}
+
+} // namespace
+
+TEST(error_test, trace_limit_unbounded_by_default) {
+    ASSERT_EQ(res::trace_limit().first, 0);
+    ASSERT_EQ(res::trace_limit().last, 0);
+
+    res::error_t error = RES_NEW_ERROR("origin");
+    for (int frame = 0; frame < 100; ++frame) {
+        error = RES_TRACE(std::move(error));
+    }
+    ASSERT_EQ(lines(error.string()).size(), 101);
+    ASSERT_EQ(error.elided_frames(), 0);
+}
+
+TEST(error_test, trace_limit_bounds_memory) {
+    const trace_limit_guard_t guard{ res::trace_limit_t{ 2, 3 } };
+    ASSERT_EQ(res::trace_limit().first, 2);
+    ASSERT_EQ(res::trace_limit().last, 3);
+
+    constexpr int frame_count = 100000;
+    res::error_t error = RES_NEW_ERROR("origin");
+    std::size_t largest = 0;
+    for (int frame = 0; frame < frame_count; ++frame) {
+        error = RES_TRACE(std::move(error));
+        largest = std::max(largest, error.string().capacity());
+    }
+
+    // Only the first and last frames are retained.
+    ASSERT_LT(largest, 2048);
+    ASSERT_EQ(error.elided_frames(), frame_count + 1 - 5);
+
+    const std::vector<std::string> retained = lines(error.string());
+    ASSERT_EQ(retained.size(), 6);
+    ASSERT_NE(retained[0].find("-> origin"), std::string::npos);
+    ASSERT_EQ(retained[2], "... 99996 frames elided ...");
+    for (const std::size_t index : { 1, 3, 4, 5 }) {
+        ASSERT_NE(retained[index].find("TestBody():"), std::string::npos);
+    }
+}
+
+TEST(error_test, trace_limit_first_or_last_only) {
+    {
+        const trace_limit_guard_t guard{ res::trace_limit_t{ 0, 2 } };
+        res::error_t error = RES_NEW_ERROR("origin");
+        for (int frame = 0; frame < 4; ++frame) {
+            error = RES_ERROR(std::move(error), std::to_string(frame));
+        }
+        const std::vector<std::string> retained = lines(error.string());
+        ASSERT_EQ(retained.size(), 3);
+        ASSERT_EQ(retained[0], "... 3 frames elided ...");
+        ASSERT_NE(retained[1].find("-> 2"), std::string::npos);
+        ASSERT_NE(retained[2].find("-> 3"), std::string::npos);
+    }
+    {
+        const trace_limit_guard_t guard{ res::trace_limit_t{ 2, 0 } };
+        res::error_t error = RES_NEW_ERROR("origin");
+        for (int frame = 0; frame < 4; ++frame) {
+            error = RES_ERROR(std::move(error), std::to_string(frame));
+        }
+        const std::vector<std::string> retained = lines(error.string());
+        ASSERT_EQ(retained.size(), 3);
+        ASSERT_NE(retained[0].find("-> origin"), std::string::npos);
+        ASSERT_NE(retained[1].find("-> 0"), std::string::npos);
+        ASSERT_EQ(retained[2], "... 3 frames elided ...");
+    }
+}
+
+TEST(error_test, trace_limit_with_error_code) {
+    const trace_limit_guard_t guard{ res::trace_limit_t{ 1, 1 } };
+    res::error_t error{ std::make_error_code(std::errc::invalid_argument) };
+    for (int frame = 0; frame < 3; ++frame) {
+        error = RES_ERROR(std::move(error), std::to_string(frame));
+    }
+
+    // The message of the code is retained ahead of the first frames.
+    std::vector<std::string> retained = lines(error.string());
+    ASSERT_EQ(retained.size(), 4);
+    ASSERT_NE(retained[0].find("[generic:"), std::string::npos);
+    ASSERT_NE(retained[1].find("-> 0"), std::string::npos);
+    ASSERT_EQ(retained[2], "... 1 frame elided ...");
+    ASSERT_NE(retained[3].find("-> 2"), std::string::npos);
+
+    error = RES_ERROR(std::move(error), "3");
+    retained = lines(error.string());
+    ASSERT_EQ(retained.size(), 4);
+    ASSERT_EQ(retained[2], "... 2 frames elided ...");
+    ASSERT_NE(retained[3].find("-> 3"), std::string::npos);
+}
+
+TEST(error_test, trace_limit_after_modification) {
+    const trace_limit_guard_t guard{ res::trace_limit_t{ 1, 1 } };
+    res::error_t error = RES_NEW_ERROR("origin");
+    for (int frame = 0; frame < 3; ++frame) {
+        error = RES_TRACE(std::move(error));
+    }
+
+    // Replacing the message restarts the count with the new message as the
+    // origin.
+    error.string() = "replaced\n";
+    for (int frame = 0; frame < 3; ++frame) {
+        error = RES_ERROR(std::move(error), std::to_string(frame));
+    }
+    const std::vector<std::string> retained = lines(error.string());
+    ASSERT_EQ(retained.size(), 4);
+    ASSERT_EQ(retained[0], "replaced");
+    ASSERT_NE(retained[1].find("-> 0"), std::string::npos);
+    ASSERT_EQ(retained[2], "... 1 frame elided ...");
+    ASSERT_NE(retained[3].find("-> 2"), std::string::npos);
+}
+
+TEST(error_test, trace_limit_with_multiline_messages) {
+    const trace_limit_guard_t guard{ res::trace_limit_t{ 1, 2 } };
+    res::error_t error = RES_NEW_ERROR("origin\nsecond line");
+    for (int frame = 0; frame < 6; ++frame) {
+        error = RES_ERROR(std::move(error), std::to_string(frame) + "\nmore");
+    }
+
+    // Frames are retained whole regardless of the lines within them.
+    const std::vector<std::string> retained = lines(error.string());
+    ASSERT_EQ(retained.size(), 7);
+    ASSERT_NE(retained[0].find("-> origin"), std::string::npos);
+    ASSERT_EQ(retained[1], "second line");
+    ASSERT_EQ(retained[2], "... 4 frames elided ...");
+    ASSERT_NE(retained[3].find("-> 4"), std::string::npos);
+    ASSERT_EQ(retained[4], "more");
+    ASSERT_NE(retained[5].find("-> 5"), std::string::npos);
+    ASSERT_EQ(retained[6], "more");
+}
+
+TEST(error_test, trace_limit_applies_to_unbounded_errors) {
+    res::error_t error = RES_NEW_ERROR("origin");
+    for (int frame = 0; frame < 4; ++frame) {
+        error = RES_TRACE(std::move(error));
+    }
+    ASSERT_FALSE(error.bounded());
+
+    // The frames received while unbounded become part of the origin.
+    const trace_limit_guard_t guard{ res::trace_limit_t{ 1, 1 } };
+    for (int frame = 0; frame < 3; ++frame) {
+        error = RES_ERROR(std::move(error), std::to_string(frame));
+    }
+    ASSERT_TRUE(error.bounded());
+    const std::vector<std::string> retained = lines(error.string());
+    ASSERT_EQ(retained.size(), 8);
+    ASSERT_NE(retained[0].find("-> origin"), std::string::npos);
+    ASSERT_NE(retained[5].find("-> 0"), std::string::npos);
+    ASSERT_EQ(retained[6], "... 1 frame elided ...");
+    ASSERT_NE(retained[7].find("-> 2"), std::string::npos);
+}
+
+TEST(error_test, trace_limit_kept_by_bounded_errors) {
+    res::error_t error = RES_NEW_ERROR("origin");
+    {
+        const trace_limit_guard_t guard{ res::trace_limit_t{ 1, 1 } };
+        error = RES_TRACE(std::move(error));
+    }
+
+    // Neither removing nor changing the limit affects a bounded error.
+    for (int frame = 0; frame < 3; ++frame) {
+        error = RES_TRACE(std::move(error));
+    }
+    const trace_limit_guard_t guard{ res::trace_limit_t{ 4, 4 } };
+    for (int frame = 0; frame < 3; ++frame) {
+        error = RES_TRACE(std::move(error));
+    }
+    const std::vector<std::string> retained = lines(error.string());
+    ASSERT_EQ(retained.size(), 4);
+    ASSERT_EQ(retained[2], "... 5 frames elided ...");
+    ASSERT_EQ(error.elided_frames(), 5);
+}
+
+TEST(error_test, trace_limit_many_last_frames) {
+    constexpr std::uint32_t last = 1000;
+    const trace_limit_guard_t guard{ res::trace_limit_t{ 1, last } };
+    constexpr int frame_count = 100000;
+    res::error_t error = RES_NEW_ERROR("origin");
+    for (int frame = 0; frame < frame_count; ++frame) {
+        error = RES_ERROR(std::move(error), std::to_string(frame));
+    }
+    ASSERT_EQ(error.elided_frames(), frame_count - last);
+
+    const std::vector<std::string> retained = lines(error.string());
+    ASSERT_EQ(retained.size(), 2 + last);
+    ASSERT_NE(retained[0].find("-> origin"), std::string::npos);
+    ASSERT_EQ(retained[1], "... 99000 frames elided ...");
+    for (std::uint32_t index = 0; index < last; ++index) {
+        const int frame = frame_count - static_cast<int>(last - index);
+        ASSERT_NE(retained[2 + index].find("-> " + std::to_string(frame)),
+          std::string::npos);
+    }
+}
+
+TEST(error_test, trace_limit_concurrent_reads) {
+    const trace_limit_guard_t guard{ res::trace_limit_t{ 1, 2 } };
+    res::error_t error = RES_NEW_ERROR("origin");
+    for (int frame = 0; frame < 10; ++frame) {
+        error = RES_TRACE(std::move(error));
+    }
+
+    // The first read of a bounded error renders its message, which const
+    // readers may do concurrently.
+    const res::error_t& shared = error;
+    std::vector<std::string> messages(4);
+    std::vector<std::thread> threads;
+    for (std::string& message : messages) {
+        threads.emplace_back(
+          [&shared, &message]() { message = shared.string(); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::string& message : messages) {
+        ASSERT_EQ(message, messages.front());
+    }
+    ASSERT_EQ(lines(messages.front()).size(), 4);
+}
@@ -0,0 +1,148 @@
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/executor.hpp"
+
+TEST(executor_test, size) {
+    res::executor_t executor{ 3 };
+    ASSERT_EQ(executor.size(), 3);
+    ASSERT_GE(res::executor_t{}.size(), 1);
+}
+
+TEST(executor_test, async) {
+    res::executor_t executor{ 2 };
+    auto future = executor.async([] { return res::optional_t<int>{ 5 }; });
+    ASSERT_EQ(future.get().value(), 5);
+
+    auto error = executor.async(
+      []() -> res::optional_t<int> { return RES_NEW_ERROR("error"); });
+    ASSERT_TRUE(error.get().has_error());
+}
+
+TEST(executor_test, exception) {
+    res::executor_t executor{ 2 };
+    auto thrown = executor.async([]() -> res::optional_t<int> {
+        throw std::runtime_error{ "thrown" };
+    });
+    auto result = thrown.get();
+    ASSERT_TRUE(result.has_error());
+    ASSERT_NE(result.error().string().find("thrown"), std::string::npos);
+
+    auto unknown = executor.async([]() -> res::optional_t<int> { throw 1; });
+    ASSERT_TRUE(unknown.get().has_error());
+
+    // The workers survive.
+    ASSERT_EQ(
+      executor.async([] { return res::optional_t<int>{ 3 }; }).get().value(),
+      3);
+}
+
+TEST(executor_test, many_tasks) {
+    res::executor_t executor{ 4 };
+    std::vector<res::future_t<int>> futures;
+    for (int index = 0; index < 10000; ++index) {
+        futures.push_back(
+          executor.async([index] { return res::optional_t<int>{ index }; }));
+    }
+
+    auto result = res::when_all(std::move(futures)).get();
+    ASSERT_TRUE(result.has_value());
+    for (int index = 0; index < 10000; ++index) {
+        ASSERT_EQ(result.value()[index], index);
+    }
+}
+
+TEST(executor_test, nested_tasks) {
+    res::executor_t executor{ 4 };
+    std::atomic<int> count = 0;
+
+    {
+        std::vector<res::future_t<int>> futures;
+        for (int outer = 0; outer < 16; ++outer) {
+            futures.push_back(executor.async([&executor, &count] {
+                // Tasks submitted from a worker go to its own queue and are
+                // stolen by idle workers.
+                for (int inner = 0; inner < 64; ++inner) {
+                    (void)executor.async([&count] {
+                        ++count;
+                        return res::optional_t<int>{ 0 };
+                    });
+                }
+                return res::optional_t<int>{ 0 };
+            }));
+        }
+        ASSERT_TRUE(res::when_all(std::move(futures)).get().has_value());
+    }
+
+    // Wait for the inner tasks by polling, since their futures were dropped.
+    while (count.load() != 16 * 64) {
+        std::this_thread::yield();
+    }
+}
+
+TEST(executor_test, uses_multiple_threads) {
+    res::executor_t executor{ 4 };
+    std::vector<res::future_t<std::thread::id>> futures;
+    for (int index = 0; index < 64; ++index) {
+        futures.push_back(executor.async([] {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+            return res::optional_t<std::thread::id>{
+                std::this_thread::get_id()
+            };
+        }));
+    }
+
+    auto result = res::when_all(std::move(futures)).get();
+    ASSERT_TRUE(result.has_value());
+    const std::set<std::thread::id> ids{
+        result.value().begin(), result.value().end()
+    };
+    ASSERT_GT(ids.size(), 1);
+}
+
+TEST(executor_test, cancellation) {
+    res::executor_t executor{ 1 };
+    res::cancellation_token_t token;
+    std::atomic<bool> release = false;
+    std::atomic<int> started = 0;
+
+    std::vector<res::future_t<int>> futures;
+    futures.push_back(executor.async(token, [&release, &started] {
+        ++started;
+        while (! release.load()) {
+            std::this_thread::yield();
+        }
+        return res::optional_t<int>{ RES_NEW_ERROR("failed") };
+    }));
+    while (started.load() == 0) {
+        std::this_thread::yield();
+    }
+    for (int index = 0; index < 8; ++index) {
+        futures.push_back(executor.async(token, [&started] {
+            ++started;
+            return res::optional_t<int>{ 0 };
+        }));
+    }
+
+    auto all = res::when_all(std::move(futures), token);
+    release.store(true);
+    auto result = all.get();
+    ASSERT_TRUE(result.has_error());
+    ASSERT_NE(result.error().string().find("failed"), std::string::npos);
+    ASSERT_TRUE(token.cancelled());
+
+    // The remaining tasks were queued behind the failing one on the only
+    // worker, so they observe the cancelled token and are skipped.
+    ASSERT_EQ(started.load(), 1);
+}
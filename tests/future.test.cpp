@@ -0,0 +1,197 @@
+// Standard includes
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/future.hpp"
+
+// A result can only be taken once, so a future must not be copied.
+static_assert(! std::is_copy_constructible_v<res::future_t<int>>);
+static_assert(! std::is_copy_assignable_v<res::future_t<int>>);
+static_assert(std::is_nothrow_move_constructible_v<res::future_t<int>>);
+
+TEST(future_test, promise_value) {
+    auto [promise, future] = res::make_promise<int>();
+    ASSERT_TRUE(future.valid());
+    ASSERT_FALSE(future.ready());
+
+    ASSERT_TRUE(promise.set(4).success());
+    ASSERT_FALSE(promise.valid());
+    ASSERT_TRUE(future.ready());
+
+    auto result = future.get();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result.value(), 4);
+    ASSERT_FALSE(future.valid());
+}
+
+TEST(future_test, promise_error) {
+    auto [promise, future] = res::make_promise<int>();
+    ASSERT_TRUE(promise.set(RES_NEW_ERROR("error")).success());
+
+    auto result = future.get();
+    ASSERT_TRUE(result.has_error());
+    ASSERT_NE(result.error().string().find("error"), std::string::npos);
+}
+
+TEST(future_test, promise_set_twice) {
+    auto [promise, future] = res::make_promise<int>();
+    ASSERT_TRUE(promise.set(1).success());
+    ASSERT_TRUE(promise.set(2).failure());
+    ASSERT_EQ(future.get().value(), 1);
+}
+
+TEST(future_test, broken_promise) {
+    res::future_t<int> future;
+    {
+        auto [promise, connected] = res::make_promise<int>();
+        future = std::move(connected);
+    }
+    ASSERT_TRUE(future.ready());
+    ASSERT_TRUE(future.get().has_error());
+}
+
+TEST(future_test, invalid_future) {
+    res::future_t<int> future;
+    ASSERT_FALSE(future.valid());
+    future.wait();
+    ASSERT_TRUE(future.get().has_error());
+}
+
+TEST(future_test, move_only_value) {
+    auto [promise, future] = res::make_promise<std::unique_ptr<int>>();
+    ASSERT_TRUE(promise.set(std::make_unique<int>(3)).success());
+    ASSERT_EQ(*(future.get().value()), 3);
+}
+
+TEST(future_test, cross_thread) {
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        auto [promise, future] = res::make_promise<int>();
+        std::thread thread{ [&promise = promise, iteration] {
+            ASSERT_TRUE(promise.set(iteration).success());
+        } };
+        ASSERT_EQ(future.get().value(), iteration);
+        thread.join();
+    }
+}
+
+TEST(future_test, cancellation_token) {
+    res::cancellation_token_t token;
+    res::cancellation_token_t copy = token;
+    ASSERT_FALSE(copy.cancelled());
+    token.cancel();
+    ASSERT_TRUE(copy.cancelled());
+}
+
+TEST(future_test, when_all_values) {
+    std::vector<res::promise_t<int>> promises;
+    std::vector<res::future_t<int>> futures;
+    for (int index = 0; index < 4; ++index) {
+        auto [promise, future] = res::make_promise<int>();
+        promises.push_back(std::move(promise));
+        futures.push_back(std::move(future));
+    }
+
+    auto all = res::when_all(std::move(futures));
+    ASSERT_TRUE(promises[2].set(2).success());
+    ASSERT_TRUE(promises[0].set(0).success());
+    ASSERT_TRUE(promises[3].set(3).success());
+    ASSERT_FALSE(all.ready());
+    ASSERT_TRUE(promises[1].set(1).success());
+
+    auto result = all.get();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result.value(), (std::vector<int>{ 0, 1, 2, 3 }));
+}
+
+TEST(future_test, when_all_fails_fast) {
+    std::vector<res::promise_t<int>> promises;
+    std::vector<res::future_t<int>> futures;
+    for (int index = 0; index < 3; ++index) {
+        auto [promise, future] = res::make_promise<int>();
+        promises.push_back(std::move(promise));
+        futures.push_back(std::move(future));
+    }
+
+    res::cancellation_token_t token;
+    auto all = res::when_all(std::move(futures), token);
+    ASSERT_TRUE(promises[0].set(0).success());
+    ASSERT_TRUE(promises[1].set(RES_NEW_ERROR("failed")).success());
+
+    // The combined future is ready before the last promise is set.
+    ASSERT_TRUE(all.ready());
+    ASSERT_TRUE(token.cancelled());
+    auto result = all.get();
+    ASSERT_TRUE(result.has_error());
+    ASSERT_NE(result.error().string().find("failed"), std::string::npos);
+
+    ASSERT_TRUE(promises[2].set(2).success());
+}
+
+TEST(future_test, when_all_invalid_future) {
+    std::vector<res::future_t<int>> futures;
+    futures.push_back(res::make_ready_future<int>(1));
+    futures.emplace_back();
+
+    auto result = res::when_all(std::move(futures)).get();
+    ASSERT_TRUE(result.has_error());
+}
+
+TEST(future_test, when_all_empty) {
+    auto result = res::when_all(std::vector<res::future_t<int>>{}).get();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(result.value().empty());
+}
+
+TEST(future_test, when_any_first_value) {
+    std::vector<res::promise_t<int>> promises;
+    std::vector<res::future_t<int>> futures;
+    for (int index = 0; index < 3; ++index) {
+        auto [promise, future] = res::make_promise<int>();
+        promises.push_back(std::move(promise));
+        futures.push_back(std::move(future));
+    }
+
+    res::cancellation_token_t token;
+    auto any = res::when_any(std::move(futures), token);
+    ASSERT_TRUE(promises[0].set(RES_NEW_ERROR("failed")).success());
+    ASSERT_FALSE(any.ready());
+    ASSERT_TRUE(promises[2].set(2).success());
+    ASSERT_TRUE(token.cancelled());
+
+    auto result = any.get();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result.value().first, 2);
+    ASSERT_EQ(result.value().second, 2);
+}
+
+TEST(future_test, when_any_all_fail) {
+    std::vector<res::future_t<int>> futures;
+    futures.push_back(res::make_ready_future<int>(RES_NEW_ERROR("first")));
+    futures.push_back(res::make_ready_future<int>(RES_NEW_ERROR("second")));
+
+    auto result = res::when_any(std::move(futures)).get();
+    ASSERT_TRUE(result.has_error());
+    ASSERT_NE(result.error().string().find("second"), std::string::npos);
+}
+
+TEST(future_test, when_any_invalid_future) {
+    std::vector<res::future_t<int>> futures;
+    futures.emplace_back();
+    futures.push_back(res::make_ready_future<int>(2));
+
+    auto result = res::when_any(std::move(futures)).get();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result.value().first, 1);
+}
+
+TEST(future_test, when_any_empty) {
+    auto result = res::when_any(std::vector<res::future_t<int>>{}).get();
+    ASSERT_TRUE(result.has_error());
+}
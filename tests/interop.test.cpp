@@ -0,0 +1,158 @@
+// Standard includes
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/optional.hpp"
+#include "../include/result.hpp"
+
+namespace {
+
+// Counts how often messages are formatted.
+class counting_category_t : public std::error_category {
+  public:
+    mutable int messages = 0;
+
+    [[nodiscard]] const char* name() const noexcept override {
+        return "counting";
+    }
+
+    [[nodiscard]] std::string message(int value) const override {
+        ++this->messages;
+        return "message " + std::to_string(value);
+    }
+};
+
+} // namespace
+
+TEST(interop_test, to_std_optional) {
+    auto value = res::optional_t<std::unique_ptr<int>>{
+        std::make_unique<int>(3)
+    }.to_std_optional();
+    ASSERT_TRUE(value.has_value());
+    ASSERT_EQ(**value, 3);
+
+    auto error =
+      res::optional_t<int>{ res::error_t{ "error" } }.to_std_optional();
+    ASSERT_FALSE(error.has_value());
+}
+
+TEST(interop_test, to_std_optional_moves_value) {
+    res::optional_t<std::string> optional{ std::string(100, 'a') };
+    const char* data = optional.value().data();
+
+    std::optional<std::string> moved = std::move(optional).to_std_optional();
+    ASSERT_EQ(moved->data(), data);
+}
+
+TEST(interop_test, error_code) {
+    const std::error_code code =
+      std::make_error_code(std::errc::no_such_file_or_directory);
+    res::error_t error{ code };
+    ASSERT_TRUE(error.has_code());
+    ASSERT_EQ(error.code(), code);
+    ASSERT_NE(error.string().find(code.message()), std::string::npos);
+
+    res::error_t plain{ "plain" };
+    ASSERT_FALSE(plain.has_code());
+    ASSERT_FALSE(plain.code());
+}
+
+TEST(interop_test, const_error_code) {
+    const std::error_code code = std::make_error_code(std::errc::io_error);
+    const res::error_t error{ code };
+    ASSERT_EQ(error.string(),
+      code.message() + " [" + code.category().name() + ":"
+        + std::to_string(code.value()) + "]\n");
+}
+
+TEST(interop_test, error_code_formatted_when_read) {
+    const counting_category_t category;
+    res::error_t error{ std::error_code{ 7, category } };
+    res::append_trace(error, RES_SITE);
+    const res::error_t copy = error;
+    ASSERT_EQ(category.messages, 0);
+
+    const std::string& string = copy.string();
+    ASSERT_EQ(category.messages, 1);
+    ASSERT_EQ(string.rfind("message 7 [counting:7]\n", 0), 0);
+    ASSERT_NE(string.find(":TestBody():"), std::string::npos);
+    ASSERT_EQ(&(copy.string()), &string);
+    ASSERT_EQ(category.messages, 1);
+
+    // A mutable reference holds the formatted message.
+    error.string().append("appended\n");
+    ASSERT_EQ(error.string().rfind("message 7 [counting:7]\n", 0), 0);
+    ASSERT_EQ(error.string().find("appended\n"),
+      error.string().size() - std::string{ "appended\n" }.size());
+    ASSERT_EQ(error.code().value(), 7);
+}
+
+TEST(interop_test, error_code_traces) {
+    const std::error_code code =
+      std::make_error_code(std::errc::permission_denied);
+    res::optional_t<int> optional{ res::error_t{ code } };
+    auto traced = std::move(optional).transform(
+      [](int value) { return value; }, RES_SITE);
+
+    // The message of the code comes first, followed by the trace.
+    const std::string string = traced.error().string();
+    ASSERT_EQ(string.find(code.message()), 0);
+    ASSERT_NE(string.find(":TestBody():"), std::string::npos);
+    ASSERT_EQ(traced.error().code(), code);
+}
+
+#if defined(__cpp_lib_expected)
+
+TEST(interop_test, to_expected) {
+    auto value = res::optional_t<std::string>{ "value" }.to_expected();
+    ASSERT_TRUE(value.has_value());
+    ASSERT_EQ(*value, "value");
+
+    auto error =
+      res::optional_t<std::string>{ res::error_t{ "error" } }.to_expected();
+    ASSERT_FALSE(error.has_value());
+    ASSERT_EQ(error.error().string(), "error");
+
+    auto success = res::result_t{}.to_expected();
+    ASSERT_TRUE(success.has_value());
+    auto failure = res::result_t{ res::error_t{ "failure" } }.to_expected();
+    ASSERT_EQ(failure.error().string(), "failure");
+
+    auto empty = res::optional_t<void>{ res::error_t{ "void" } }.to_expected();
+    ASSERT_EQ(empty.error().string(), "void");
+}
+
+TEST(interop_test, from_expected) {
+    auto value = res::from_expected(std::expected<int, res::error_t>{ 4 });
+    ASSERT_EQ(value.value(), 4);
+
+    auto error = res::from_expected(std::expected<int, res::error_t>{
+      std::unexpect, res::error_t{ "error" } });
+    ASSERT_EQ(error.error().string(), "error");
+
+    auto string = res::from_expected(
+      std::expected<int, std::string>{ std::unexpect, "string" });
+    ASSERT_EQ(string.error().string(), "string");
+
+    const std::error_code code = std::make_error_code(std::errc::timed_out);
+    auto system = res::from_expected(
+      std::expected<int, std::error_code>{ std::unexpect, code });
+    ASSERT_EQ(system.error().code(), code);
+
+    auto errc = res::from_expected(std::expected<int, std::errc>{
+      std::unexpect, std::errc::timed_out });
+    ASSERT_EQ(errc.error().code(), code);
+
+    res::result_t result =
+      res::from_expected(std::expected<void, res::error_t>{});
+    ASSERT_TRUE(result.success());
+}
+
+#endif
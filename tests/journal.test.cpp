@@ -0,0 +1,241 @@
+// Standard includes
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/journal.hpp"
+
+namespace {
+
+// Counts allocations made by the calling thread.
+thread_local std::size_t allocation_count = 0;
+
+std::string journal_path(const std::string& name) {
+    const auto path =
+      std::filesystem::temp_directory_path() / ("cpp_result_" + name);
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*unused*/) noexcept {
+    std::free(pointer);
+}
+
+TEST(journal_test, open_invalid_geometry) {
+    const std::string path = journal_path("invalid_geometry");
+    ASSERT_TRUE(res::journal_t::open(path, 0, 1).has_error());
+    ASSERT_TRUE(res::journal_t::open(path, 1, 0).has_error());
+    ASSERT_TRUE(res::journal_t::open(path, 1, 1, 100).has_error());
+}
+
+TEST(journal_test, append_and_read) {
+    const std::string path = journal_path("append_and_read");
+    {
+        auto journal = res::journal_t::open(path, 4, 8);
+        ASSERT_TRUE(journal.has_value());
+        ASSERT_TRUE(journal.value().append(RES_NEW_ERROR("first")).success());
+        ASSERT_TRUE(journal.value().append(RES_NEW_ERROR("second")).success());
+    }
+
+    auto entries = res::read_journal(path);
+    ASSERT_TRUE(entries.has_value());
+    ASSERT_EQ(entries.value().size(), 2);
+    ASSERT_NE(
+      entries.value()[0].error.string().find("first"), std::string::npos);
+    ASSERT_NE(
+      entries.value()[1].error.string().find("second"), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, survives_without_unmapping) {
+    const std::string path = journal_path("survives_without_unmapping");
+    auto journal = res::journal_t::open(path, 1, 4);
+    ASSERT_TRUE(journal.has_value());
+    const auto error = RES_TRACE(RES_NEW_ERROR("still mapped"));
+    ASSERT_TRUE(journal.value().append(error).success());
+
+    // The record is readable while the writer still holds the mapping, which
+    // is the state the file is left in when the writer crashes.
+    auto entries = res::read_journal(path);
+    ASSERT_TRUE(entries.has_value());
+    ASSERT_EQ(entries.value().size(), 1);
+    ASSERT_EQ(entries.value()[0].error.string(), error.string());
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, retains_most_recent) {
+    const std::string path = journal_path("retains_most_recent");
+    auto journal = res::journal_t::open(path, 1, 4);
+    ASSERT_TRUE(journal.has_value());
+    for (int index = 0; index < 10; ++index) {
+        ASSERT_TRUE(journal.value()
+                      .append(res::error_t{ std::to_string(index) })
+                      .success());
+    }
+
+    auto entries = res::read_journal(path);
+    ASSERT_TRUE(entries.has_value());
+    ASSERT_EQ(entries.value().size(), 4);
+    for (size_t index = 0; index < 4; ++index) {
+        ASSERT_EQ(entries.value()[index].error.string(),
+          std::to_string(index + 6));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, reopen_appends) {
+    const std::string path = journal_path("reopen_appends");
+    for (int run = 0; run < 3; ++run) {
+        auto journal = res::journal_t::open(path, 2, 8);
+        ASSERT_TRUE(journal.has_value());
+        ASSERT_TRUE(journal.value()
+                      .append(res::error_t{ std::to_string(run) })
+                      .success());
+    }
+
+    auto entries = res::read_journal(path);
+    ASSERT_TRUE(entries.has_value());
+    ASSERT_EQ(entries.value().size(), 3);
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, record_too_large) {
+    const std::string path = journal_path("record_too_large");
+    auto journal = res::journal_t::open(path, 1, 1, 64);
+    ASSERT_TRUE(journal.has_value());
+    ASSERT_TRUE(journal.value()
+                  .append(res::error_t{ std::string(1000, 'x') })
+                  .failure());
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, record_too_large_keeps_existing) {
+    const std::string path = journal_path("record_too_large_keeps_existing");
+    auto journal = res::journal_t::open(path, 1, 1, 256);
+    ASSERT_TRUE(journal.has_value());
+    ASSERT_TRUE(journal.value().append(res::error_t{ "good" }).success());
+    ASSERT_TRUE(journal.value()
+                  .append(res::error_t{ std::string(1000, 'x') })
+                  .failure());
+
+    auto entries = res::read_journal(path);
+    ASSERT_TRUE(entries.has_value());
+    ASSERT_EQ(entries.value().size(), 1);
+    ASSERT_EQ(entries.value()[0].error.string(), "good");
+    ASSERT_EQ(entries.value()[0].sequence, 1);
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, append_does_not_allocate) {
+    const std::string path = journal_path("append_does_not_allocate");
+    auto journal = res::journal_t::open(path, 1, 4);
+    ASSERT_TRUE(journal.has_value());
+    const auto error = RES_TRACE(RES_TRACE(RES_NEW_ERROR("no allocation")));
+
+    const std::size_t before = allocation_count;
+    const bool appended = journal.value().append(error).success();
+    const std::size_t allocations = allocation_count - before;
+    ASSERT_TRUE(appended);
+    ASSERT_EQ(allocations, 0);
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, open_keeps_other_files) {
+    const std::string path = journal_path("open_keeps_other_files");
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    const std::string contents(4096, 'x');
+    std::fwrite(contents.data(), 1, contents.size(), file);
+    std::fclose(file);
+
+    ASSERT_TRUE(res::journal_t::open(path, 1, 4).has_error());
+    ASSERT_EQ(std::filesystem::file_size(path), contents.size());
+
+    auto journal = res::journal_t::open(path, 1, 4, 1024, true);
+    ASSERT_TRUE(journal.has_value());
+    ASSERT_TRUE(journal.value().append(res::error_t{ "new" }).success());
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, open_keeps_other_geometry) {
+    const std::string path = journal_path("open_keeps_other_geometry");
+    {
+        auto journal = res::journal_t::open(path, 2, 4);
+        ASSERT_TRUE(journal.has_value());
+        ASSERT_TRUE(journal.value().append(res::error_t{ "crash" }).success());
+    }
+
+    ASSERT_TRUE(res::journal_t::open(path, 4, 4).has_error());
+    auto entries = res::read_journal(path);
+    ASSERT_TRUE(entries.has_value());
+    ASSERT_EQ(entries.value().size(), 1);
+    ASSERT_EQ(entries.value()[0].error.string(), "crash");
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, concurrent_writers) {
+    const std::string path = journal_path("concurrent_writers");
+    auto journal = res::journal_t::open(path, 8, 64);
+    ASSERT_TRUE(journal.has_value());
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 8; ++thread) {
+        threads.emplace_back([&journal, thread]() {
+            for (int index = 0; index < 32; ++index) {
+                EXPECT_TRUE(
+                  journal.value()
+                    .append(res::error_t{ std::to_string(thread) + ":"
+                      + std::to_string(index) })
+                    .success());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto entries = res::read_journal(path);
+    ASSERT_TRUE(entries.has_value());
+    std::set<std::string> unique;
+    for (const auto& entry : entries.value()) {
+        unique.insert(entry.error.string());
+    }
+    ASSERT_EQ(unique.size(), 8 * 32);
+    std::filesystem::remove(path);
+}
+
+TEST(journal_test, read_invalid_file) {
+    const std::string path = journal_path("read_invalid_file");
+    ASSERT_TRUE(res::read_journal(path).has_error());
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    const std::string contents(4096, 'x');
+    std::fwrite(contents.data(), 1, contents.size(), file);
+    std::fclose(file);
+    ASSERT_TRUE(res::read_journal(path).has_error());
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,227 @@
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/memo.hpp"
+
+namespace {
+
+// A clock that only advances when told to.
+struct manual_clock_t {
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<manual_clock_t>;
+    static constexpr bool is_steady = true;
+
+    static inline time_point current{};
+
+    static time_point now() {
+        return current;
+    }
+
+    static void advance(duration duration) {
+        current += duration;
+    }
+};
+
+using cache_t =
+  res::memo_cache_t<int, std::string, std::hash<int>, manual_clock_t>;
+
+res::memo_options_t options(
+  std::chrono::seconds success_ttl, std::chrono::seconds failure_ttl) {
+    res::memo_options_t options;
+    options.success_ttl = success_ttl;
+    options.failure_ttl = failure_ttl;
+    options.shard_count = 4;
+    return options;
+}
+
+} // namespace
+
+TEST(memo_test, caches_values) {
+    int calls = 0;
+    cache_t cache{ [&calls](int key) {
+                      ++calls;
+                      return res::optional_t<std::string>{ std::to_string(
+                        key) };
+                  },
+        options(std::chrono::seconds{ 10 }, std::chrono::seconds{ 10 }) };
+
+    auto first = cache.get(1);
+    auto second = cache.get(1);
+    ASSERT_EQ(first->value(), "1");
+    ASSERT_EQ(calls, 1);
+
+    // Hits share the cached result instead of copying it.
+    ASSERT_EQ(first.get(), second.get());
+
+    ASSERT_EQ(cache.get(2)->value(), "2");
+    ASSERT_EQ(calls, 2);
+    ASSERT_EQ(cache.size(), 2);
+
+    const res::memo_stats_t stats = cache.stats();
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(stats.misses, 2);
+    ASSERT_EQ(stats.coalesced, 0);
+}
+
+TEST(memo_test, caches_errors_with_separate_ttl) {
+    int calls = 0;
+    cache_t cache{ [&calls](int key) -> res::optional_t<std::string> {
+                      ++calls;
+                      if (key < 0) {
+                          return RES_NEW_ERROR("negative");
+                      }
+                      return std::to_string(key);
+                  },
+        options(std::chrono::seconds{ 10 }, std::chrono::seconds{ 2 }) };
+
+    auto error = cache.get(-1);
+    ASSERT_TRUE(error->has_error());
+    ASSERT_EQ(cache.get(-1).get(), error.get());
+    ASSERT_EQ(calls, 1);
+
+    // Hits share the stored error rather than copying it.
+    ASSERT_EQ(&(cache.get(-1)->error_ref()), &(error->error_ref()));
+    ASSERT_NE(error->error_ref().string().find("negative"), std::string::npos);
+
+    (void)cache.get(1);
+    ASSERT_EQ(calls, 2);
+
+    // The error expires before the value.
+    manual_clock_t::advance(std::chrono::seconds{ 3 });
+    (void)cache.get(-1);
+    (void)cache.get(1);
+    ASSERT_EQ(calls, 3);
+
+    manual_clock_t::advance(std::chrono::seconds{ 10 });
+    (void)cache.get(1);
+    ASSERT_EQ(calls, 4);
+}
+
+TEST(memo_test, unbounded_ttl) {
+    int calls = 0;
+    res::memo_options_t never;
+    never.success_ttl = std::chrono::nanoseconds::max();
+    cache_t cache{ [&calls](int key) {
+                      ++calls;
+                      return res::optional_t<std::string>{ std::to_string(
+                        key) };
+                  },
+        never };
+
+    // The expiry would overflow unless it saturates.
+    manual_clock_t::advance(std::chrono::hours{ 1 });
+    (void)cache.get(1);
+    manual_clock_t::advance(std::chrono::hours{ 24 * 365 * 100 });
+    (void)cache.get(1);
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(memo_test, failure_caching_disabled) {
+    int calls = 0;
+    cache_t cache{ [&calls](int) -> res::optional_t<std::string> {
+                      ++calls;
+                      return RES_NEW_ERROR("error");
+                  },
+        options(std::chrono::seconds{ 10 }, std::chrono::seconds{ 0 }) };
+
+    (void)cache.get(1);
+    (void)cache.get(1);
+    ASSERT_EQ(calls, 2);
+    ASSERT_EQ(cache.size(), 0);
+}
+
+TEST(memo_test, erase_prune_clear) {
+    int calls = 0;
+    cache_t cache{ [&calls](int key) {
+                      ++calls;
+                      return res::optional_t<std::string>{ std::to_string(
+                        key) };
+                  },
+        options(std::chrono::seconds{ 5 }, std::chrono::seconds{ 5 }) };
+
+    (void)cache.get(1);
+    cache.erase(1);
+    (void)cache.get(1);
+    ASSERT_EQ(calls, 2);
+
+    (void)cache.get(2);
+    manual_clock_t::advance(std::chrono::seconds{ 6 });
+    ASSERT_EQ(cache.size(), 2);
+    cache.prune();
+    ASSERT_EQ(cache.size(), 0);
+
+    (void)cache.get(3);
+    ASSERT_EQ(cache.stats().misses, 4);
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+
+    // Clearing resets the counters too.
+    ASSERT_EQ(cache.stats().hits, 0);
+    ASSERT_EQ(cache.stats().misses, 0);
+    ASSERT_EQ(cache.stats().coalesced, 0);
+}
+
+TEST(memo_test, coalesces_concurrent_misses) {
+    constexpr int thread_count = 8;
+    std::atomic<int> calls = 0;
+    std::atomic<bool> release = false;
+
+    res::memo_cache_t<int, int> cache{ [&](int key) {
+        ++calls;
+        while (! release.load()) {
+            std::this_thread::yield();
+        }
+        return res::optional_t<int>{ key * 2 };
+    } };
+
+    std::vector<std::thread> threads;
+    std::vector<res::memo_cache_t<int, int>::result_ptr_t> results(
+      thread_count);
+    for (int index = 0; index < thread_count; ++index) {
+        threads.emplace_back(
+          [&cache, &results, index] { results[index] = cache.get(7); });
+    }
+
+    // Wait until every thread has either started the call or is waiting on it.
+    while (cache.stats().misses + cache.stats().coalesced != thread_count) {
+        std::this_thread::yield();
+    }
+    release.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(calls.load(), 1);
+    for (const auto& result : results) {
+        ASSERT_EQ(result.get(), results.front().get());
+        ASSERT_EQ(result->value(), 14);
+    }
+    ASSERT_EQ(cache.stats().coalesced, thread_count - 1);
+}
+
+TEST(memo_test, exception) {
+    bool fail = true;
+    res::memo_cache_t<int, int> cache{ [&fail](int key) {
+        if (fail) {
+            throw std::runtime_error{ "thrown" };
+        }
+        return res::optional_t<int>{ key };
+    } };
+
+    ASSERT_THROW((void)cache.get(1), std::runtime_error);
+    ASSERT_EQ(cache.size(), 0);
+
+    fail = false;
+    ASSERT_EQ(cache.get(1)->value(), 1);
+}
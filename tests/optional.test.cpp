@@ -1,3 +1,10 @@
+// Standard includes
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 // External includes
 #include <gtest/gtest.h>
 
@@ -22,6 +29,16 @@ TEST(optional_test, optional_move_error_constructor) {
     ASSERT_EQ(optional.error().string().size(), 0);
 }
 
+TEST(optional_test, error_ref) {
+    const res::optional_t<std::string> error{ res::error_t{ "some error" } };
+    const res::error_t& stored = error.error_ref();
+    ASSERT_EQ(&stored, &(error.error_ref()));
+    ASSERT_EQ(stored.string(), "some error");
+
+    const res::optional_t<std::string> value{ "value" };
+    ASSERT_EQ(value.error_ref().string(), value.error().string());
+}
+
 TEST(optional_test, optional_copy_equal_operator_error) {
     res::error_t error{ "some error" };
     res::optional_t<std::string> optional = error;
@@ -250,3 +267,345 @@ TEST(optional_test, optional_release) {
     ASSERT_FALSE(optional.has_error());
     delete released_value;
 }
+
+namespace {
+
+res::optional_t<int> half(int value) {
+    if (value % 2 != 0) {
+        return RES_NEW_ERROR("odd");
+    }
+    return value / 2;
+}
+
+} // namespace
+
+TEST(optional_test, optional_and_then_value) {
+    res::optional_t<int> optional{ 8 };
+    ASSERT_EQ(optional.and_then(half).value(), 4);
+    ASSERT_EQ(std::as_const(optional).and_then(half).value(), 4);
+    ASSERT_EQ(std::move(optional).and_then(half).and_then(half).value(), 2);
+}
+
+TEST(optional_test, optional_and_then_error) {
+    res::optional_t<int> optional = half(3);
+    const std::string expected = optional.error().string();
+    ASSERT_EQ(optional.and_then(half).error().string(), expected);
+
+    int calls = 0;
+    auto counted = [&calls](int value) {
+        ++calls;
+        return half(value);
+    };
+    ASSERT_TRUE(optional.and_then(counted).has_error());
+    ASSERT_TRUE(std::as_const(optional).and_then(counted).has_error());
+    ASSERT_TRUE(std::move(optional).and_then(counted).has_error());
+    ASSERT_EQ(calls, 0);
+}
+
+TEST(optional_test, optional_and_then_site) {
+    const res::optional_t<int> optional = half(3);
+    const auto traced = optional.and_then(half, RES_SITE);
+    ASSERT_TRUE(traced.has_error());
+    ASSERT_EQ(traced.error().string().rfind(optional.error().string(), 0), 0);
+    ASSERT_GT(traced.error().string().size(), optional.error().string().size());
+
+    const auto untraced = optional.and_then(half);
+    ASSERT_EQ(untraced.error().string(), optional.error().string());
+}
+
+TEST(optional_test, optional_and_then_moves_value) {
+    res::optional_t<std::unique_ptr<int>> optional{ std::make_unique<int>(5) };
+    auto moved = std::move(optional).and_then(
+      [](std::unique_ptr<int>&& value) -> res::optional_t<int> {
+          return *value;
+      });
+    ASSERT_EQ(moved.value(), 5);
+}
+
+TEST(optional_test, optional_and_then_moves_error) {
+    res::optional_t<int> optional{ res::error_t{ std::string(100, 'x') } };
+    auto moved = std::move(optional).and_then(half);
+    ASSERT_TRUE(moved.has_error());
+    ASSERT_FALSE(optional.has_error()); // NOLINT(bugprone-use-after-move)
+}
+
+TEST(optional_test, optional_transform) {
+    res::optional_t<int> optional{ 4 };
+    auto to_string = [](int value) { return std::to_string(value); };
+    ASSERT_EQ(optional.transform(to_string).value(), "4");
+    ASSERT_EQ(std::as_const(optional).transform(to_string).value(), "4");
+    ASSERT_EQ(std::move(optional).transform(to_string).value(), "4");
+
+    res::optional_t<int> error = half(1);
+    const std::string expected = error.error().string();
+    ASSERT_EQ(error.transform(to_string).error().string(), expected);
+    ASSERT_EQ(std::move(error).transform(to_string).error().string(), expected);
+}
+
+TEST(optional_test, optional_transform_moves_value) {
+    res::optional_t<std::string> optional{ std::string(100, 'x') };
+    auto length = std::move(optional).transform(
+      [](std::string&& value) { return std::move(value); });
+    ASSERT_EQ(length.value().size(), 100);
+    ASSERT_TRUE(optional.value().empty()); // NOLINT(bugprone-use-after-move)
+}
+
+TEST(optional_test, optional_transform_void) {
+    int calls = 0;
+    auto count = [&calls](int value) { calls += value; };
+    res::optional_t<int> optional{ 2 };
+    const res::optional_t<void> first = optional.transform(count);
+    const res::optional_t<void> second =
+      std::as_const(optional).transform(count);
+    const res::optional_t<void> third = std::move(optional).transform(count);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    ASSERT_TRUE(third.has_value());
+    ASSERT_EQ(calls, 6);
+
+    res::optional_t<int> error = half(1);
+    ASSERT_TRUE(error.transform(count).has_error());
+    ASSERT_TRUE(std::move(error).transform(count, RES_SITE).has_error());
+    ASSERT_EQ(calls, 6);
+
+    int referred = 3;
+    const res::optional_t<int&> reference{ referred };
+    ASSERT_TRUE(reference.transform([](int& value) { ++value; }).has_value());
+    ASSERT_EQ(referred, 4);
+}
+
+TEST(optional_test, optional_or_else) {
+    auto recover = [](const res::error_t&) -> res::optional_t<int> {
+        return 0;
+    };
+    res::optional_t<int> error = half(1);
+    ASSERT_EQ(error.or_else(recover).value(), 0);
+    ASSERT_EQ(std::as_const(error).or_else(recover).value(), 0);
+    ASSERT_EQ(std::move(error).or_else(recover).value(), 0);
+
+    res::optional_t<int> value{ 4 };
+    ASSERT_EQ(value.or_else(recover).value(), 4);
+    ASSERT_EQ(std::move(value).or_else(recover).value(), 4);
+}
+
+TEST(optional_test, optional_or_else_moves_error) {
+    res::optional_t<int> optional{ res::error_t{ "original" } };
+    auto recovered = std::move(optional).or_else(
+      [](res::error_t&& error) -> res::optional_t<int> {
+          return RES_ERROR(std::move(error), "recovery failed");
+      });
+    ASSERT_TRUE(recovered.has_error());
+    ASSERT_EQ(recovered.error().string().rfind("original", 0), 0);
+}
+
+TEST(optional_test, optional_transform_error) {
+    auto replace = [](const res::error_t&) { return res::error_t{ "new" }; };
+    res::optional_t<int> error = half(1);
+    ASSERT_EQ(error.transform_error(replace).error().string(), "new");
+    ASSERT_EQ(
+      std::as_const(error).transform_error(replace).error().string(), "new");
+    ASSERT_EQ(
+      std::move(error).transform_error(replace).error().string(), "new");
+
+    res::optional_t<int> value{ 4 };
+    ASSERT_EQ(value.transform_error(replace).value(), 4);
+
+    const auto traced =
+      res::optional_t<int>{ res::error_t{ "" } }.transform_error(
+        replace, RES_SITE);
+    ASSERT_EQ(traced.error().string().rfind("new", 0), 0);
+    ASSERT_GT(traced.error().string().size(), 3);
+}
+
+TEST(optional_test, optional_pipeline) {
+    auto result = half(40)
+                    .and_then(half, RES_SITE)
+                    .transform([](int value) { return value + 2; })
+                    .and_then(half, RES_SITE)
+                    .or_else([](const res::error_t&) -> res::optional_t<int> {
+                        return -1;
+                    });
+    ASSERT_EQ(result.value(), 6);
+
+    auto failure = half(40)
+                     .and_then(half)
+                     .transform([](int value) { return value + 1; })
+                     .and_then(half, RES_SITE)
+                     .and_then(half, RES_SITE);
+    ASSERT_TRUE(failure.has_error());
+}
+
+namespace {
+
+res::optional_t<const std::string&> lookup(
+  const std::map<int, std::string>& cache, int key) {
+    auto entry = cache.find(key);
+    if (entry == cache.end()) {
+        return RES_NEW_ERROR("missing key");
+    }
+    return entry->second;
+}
+
+} // namespace
+
+TEST(optional_test, reference_refers_without_copying) {
+    const std::map<int, std::string> cache{ { 1, "one" } };
+
+    auto found = lookup(cache, 1);
+    ASSERT_TRUE(found.has_value());
+    ASSERT_EQ(&(found.value()), &(cache.at(1)));
+    ASSERT_EQ(found->size(), 3);
+
+    auto missing = lookup(cache, 2);
+    ASSERT_TRUE(missing.has_error());
+    ASSERT_THROW((void)missing.value(), res::bad_optional_access_t);
+    ASSERT_NE(missing.error().string().find("missing key"), std::string::npos);
+}
+
+TEST(optional_test, reference_no_heap_storage) {
+    ASSERT_EQ(sizeof(res::optional_t<int&>),
+      sizeof(int*) + sizeof(std::unique_ptr<res::error_t>));
+}
+
+TEST(optional_test, reference_mutation_and_rebinding) {
+    int first = 1;
+    int second = 2;
+
+    res::optional_t<int&> reference{ first };
+    reference.value() = 10;
+    ASSERT_EQ(first, 10);
+
+    // Assigning an object refers to it instead of assigning through.
+    reference = second;
+    ASSERT_EQ(&(reference.value()), &second);
+    ASSERT_EQ(first, 10);
+
+    const res::optional_t<int&> copy = reference;
+    ASSERT_EQ(&(copy.value()), &second);
+
+    reference = res::error_t{ "error" };
+    ASSERT_TRUE(reference.has_error());
+    ASSERT_TRUE(copy.has_value());
+
+    static_assert(! std::is_constructible_v<res::optional_t<const int&>, int>);
+}
+
+TEST(optional_test, reference_conversions) {
+    res::optional_t<std::string> owner{ std::string{ "value" } };
+
+    // Refer to the value of another optional_t.
+    res::optional_t<std::string&> reference = owner;
+    ASSERT_EQ(&(reference.value()), &(owner.value()));
+    const res::optional_t<std::string>& const_owner = owner;
+    res::optional_t<const std::string&> const_reference = const_owner;
+    ASSERT_EQ(&(const_reference.value()), &(owner.value()));
+
+    // Copy the referred object explicitly.
+    res::optional_t<std::string> copy{ reference };
+    ASSERT_EQ(copy.value(), "value");
+    ASSERT_NE(&(copy.value()), &(owner.value()));
+
+    res::optional_t<std::string> error_owner{ res::error_t{ "error" } };
+    res::optional_t<std::string&> error_reference = error_owner;
+    ASSERT_EQ(error_reference.error().string(), "error");
+    ASSERT_EQ(res::optional_t<std::string>{ error_reference }.error().string(),
+      "error");
+
+    static_assert(! std::is_constructible_v<res::optional_t<std::string&>,
+                  res::optional_t<std::string>&&>);
+    static_assert(! std::is_convertible_v<res::optional_t<std::string&>,
+                  res::optional_t<std::string>>);
+}
+
+TEST(optional_test, reference_combinators) {
+    std::string value{ "value" };
+    res::optional_t<std::string&> reference{ value };
+
+    ASSERT_EQ(reference.transform([](std::string& string) {
+        string += "!";
+        return string.size();
+    }).value(), 6);
+    ASSERT_EQ(value, "value!");
+
+    auto chained = reference.and_then(
+      [](std::string& string) -> res::optional_t<char&> {
+          return string.front();
+      });
+    ASSERT_EQ(&(chained.value()), value.data());
+
+    res::optional_t<std::string&> error{ res::error_t{ "" } };
+    auto traced = std::move(error).transform(
+      [](std::string& string) { return string.size(); }, RES_SITE);
+    ASSERT_TRUE(traced.has_error());
+    ASSERT_FALSE(traced.error().string().empty());
+
+    std::string fallback{ "fallback" };
+    res::optional_t<std::string&> missing{ res::error_t{ "" } };
+    auto recovered = missing.or_else(
+      [&fallback](const res::error_t&) -> res::optional_t<std::string&> {
+          return fallback;
+      });
+    ASSERT_EQ(&(recovered.value()), &fallback);
+}
+
+TEST(optional_test, void_value_and_error) {
+    const res::optional_t<void> value;
+    ASSERT_TRUE(value.has_value());
+    ASSERT_FALSE(value.has_error());
+    ASSERT_NO_THROW(value.value());
+    ASSERT_EQ(value.error().string(), "Has value");
+
+    const res::optional_t<void> error{ res::error_t{ "error" } };
+    ASSERT_TRUE(error.has_error());
+    ASSERT_THROW(error.value(), res::bad_optional_access_t);
+    ASSERT_EQ(error.error().string(), "error");
+}
+
+TEST(optional_test, void_result_conversions) {
+    static_assert(sizeof(res::optional_t<void>) == sizeof(res::result_t));
+
+    res::optional_t<void> from_success = res::success;
+    ASSERT_TRUE(from_success.has_value());
+    res::optional_t<void> from_failure = res::result_t{ res::error_t{ "a" } };
+    ASSERT_EQ(from_failure.error().string(), "a");
+
+    res::result_t copied = from_failure;
+    ASSERT_EQ(copied.error().string(), "a");
+    res::result_t moved = std::move(from_failure);
+    ASSERT_TRUE(moved.failure());
+    ASSERT_EQ(moved.error().string(), "a");
+
+    res::result_t success = res::optional_t<void>{};
+    ASSERT_TRUE(success.success());
+}
+
+TEST(optional_test, void_combinators) {
+    int calls = 0;
+    const res::optional_t<void> value;
+
+    auto transformed = value.transform([&calls] { ++calls; });
+    static_assert(
+      std::is_same_v<decltype(transformed), res::optional_t<void>>);
+    ASSERT_TRUE(transformed.has_value());
+    ASSERT_EQ(calls, 1);
+
+    ASSERT_EQ(value.transform([] { return 3; }).value(), 3);
+    ASSERT_EQ(value.and_then([] { return res::optional_t<int>{ 4 }; }).value(),
+      4);
+
+    res::optional_t<void> error{ res::error_t{ "" } };
+    auto traced = error.transform([&calls] { ++calls; }, RES_SITE);
+    ASSERT_TRUE(traced.has_error());
+    ASSERT_FALSE(traced.error().string().empty());
+    ASSERT_EQ(calls, 1);
+
+    auto recovered = std::move(error).or_else(
+      [](res::error_t&&) { return res::optional_t<void>{}; });
+    ASSERT_TRUE(recovered.has_value());
+
+    auto replaced = res::optional_t<void>{ res::error_t{ "old" } }
+                      .transform_error([](const res::error_t&) {
+                          return res::error_t{ "new" };
+                      });
+    ASSERT_EQ(replaced.error().string(), "new");
+}
@@ -0,0 +1,216 @@
+// Standard includes
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/parallel.hpp"
+
+namespace {
+
+std::vector<int> iota(int size) {
+    std::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    return values;
+}
+
+res::optional_t<int> square(int value) {
+    if (value < 0) {
+        return RES_NEW_ERROR("negative " + std::to_string(value));
+    }
+    return value * value;
+}
+
+} // namespace
+
+TEST(parallel_test, transform) {
+    res::executor_t executor{ 4 };
+    const std::vector<int> values = iota(1001);
+
+    auto result = res::parallel::transform(
+      executor, values.begin(), values.end(), square);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result.value().size(), values.size());
+    for (int value : values) {
+        ASSERT_EQ(result.value()[value], value * value);
+    }
+}
+
+TEST(parallel_test, transform_empty) {
+    const std::vector<int> values;
+    auto result =
+      res::parallel::transform(values.begin(), values.end(), square);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(result.value().empty());
+}
+
+TEST(parallel_test, transform_fewer_elements_than_chunks) {
+    res::executor_t executor{ 8 };
+    const std::vector<int> values = iota(3);
+    auto result = res::parallel::transform(
+      executor, values.begin(), values.end(), square);
+    ASSERT_EQ(result.value(), (std::vector<int>{ 0, 1, 4 }));
+}
+
+TEST(parallel_test, transform_bool) {
+    res::executor_t executor{ 4 };
+    const std::vector<int> values = iota(100001);
+
+    // Neighbouring values are assigned by different chunks.
+    auto result = res::parallel::transform(
+      executor, values.begin(), values.end(), [](int value) {
+          return res::optional_t<bool>{ value % 3 == 0 };
+      });
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result.value().size(), values.size());
+    for (int value : values) {
+        ASSERT_EQ(result.value()[value], value % 3 == 0);
+    }
+}
+
+TEST(parallel_test, transform_first_error) {
+    res::executor_t executor{ 4 };
+    std::vector<int> values = iota(100000);
+    values[10] = -1;
+
+    std::atomic<int> calls = 0;
+    auto result = res::parallel::transform(executor,
+      values.begin(),
+      values.end(),
+      [&calls](int value) {
+          ++calls;
+          return square(value);
+      });
+    ASSERT_TRUE(result.has_error());
+    ASSERT_NE(result.error().string().find("negative -1"), std::string::npos);
+
+    // Only the first error is reported.
+    ASSERT_EQ(result.error().string().find("negative -1"),
+      result.error().string().rfind("negative -1"));
+
+    // Workers stop after the failure instead of finishing the range.
+    ASSERT_LT(calls.load(), static_cast<int>(values.size()));
+}
+
+TEST(parallel_test, transform_all_errors) {
+    res::executor_t executor{ 4 };
+    std::vector<int> values = iota(1000);
+    values[900] = -900;
+    values[5] = -5;
+    values[500] = -500;
+
+    auto result = res::parallel::transform(executor,
+      values.begin(),
+      values.end(),
+      square,
+      res::parallel::errors_t::all);
+    ASSERT_TRUE(result.has_error());
+
+    // Every error is reported in the order of the elements.
+    const std::string error = result.error().string();
+    const auto first = error.find("negative -5");
+    const auto second = error.find("negative -500");
+    const auto third = error.find("negative -900");
+    ASSERT_NE(first, std::string::npos);
+    ASSERT_NE(second, std::string::npos);
+    ASSERT_NE(third, std::string::npos);
+    ASSERT_LT(first, second);
+    ASSERT_LT(second, third);
+}
+
+TEST(parallel_test, transform_exception) {
+    res::executor_t executor{ 4 };
+    const std::vector<int> values = iota(100);
+    auto result = res::parallel::transform(executor,
+      values.begin(),
+      values.end(),
+      [](int value) -> res::optional_t<int> {
+          if (value == 50) {
+              throw std::runtime_error{ "thrown" };
+          }
+          return value;
+      });
+    ASSERT_TRUE(result.has_error());
+    ASSERT_NE(result.error().string().find("thrown"), std::string::npos);
+}
+
+TEST(parallel_test, for_each) {
+    res::executor_t executor{ 4 };
+    const std::vector<int> values = iota(1000);
+    std::vector<std::atomic<int>> visits(values.size());
+
+    auto result = res::parallel::for_each(
+      executor, values.begin(), values.end(), [&visits](int value) {
+          ++visits[value];
+          return res::result_t{};
+      });
+    ASSERT_TRUE(result.success());
+    for (const std::atomic<int>& count : visits) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+TEST(parallel_test, for_each_error) {
+    const std::vector<int> values = iota(1000);
+    auto result = res::parallel::for_each(
+      values.begin(), values.end(), [](int value) -> res::result_t {
+          if (value == 700) {
+              return RES_NEW_ERROR("failed");
+          }
+          return res::success;
+      });
+    ASSERT_TRUE(result.failure());
+    ASSERT_NE(result.error().string().find("failed"), std::string::npos);
+}
+
+TEST(parallel_test, transform_reduce) {
+    res::executor_t executor{ 3 };
+    const std::vector<int> values = iota(1001);
+
+    auto result = res::parallel::transform_reduce(
+      executor,
+      values.begin(),
+      values.end(),
+      std::int64_t{ 0 },
+      [](std::int64_t lhs, std::int64_t rhs) { return lhs + rhs; },
+      [](int value) { return res::optional_t<std::int64_t>{ value }; });
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result.value(), 1000 * 1001 / 2);
+}
+
+TEST(parallel_test, transform_reduce_order) {
+    // String concatenation is associative but not commutative, so chunks must
+    // be combined in order.
+    res::executor_t executor{ 4 };
+    const std::vector<int> values = iota(26);
+
+    auto result = res::parallel::transform_reduce(
+      executor,
+      values.begin(),
+      values.end(),
+      std::string{},
+      [](std::string lhs, const std::string& rhs) { return lhs + rhs; },
+      [](int value) {
+          return res::optional_t<std::string>{ std::string(
+            1, static_cast<char>('a' + value)) };
+      });
+    ASSERT_EQ(result.value(), "abcdefghijklmnopqrstuvwxyz");
+}
+
+TEST(parallel_test, transform_reduce_error) {
+    std::vector<int> values = iota(1000);
+    values[999] = -1;
+
+    auto result = res::parallel::transform_reduce(
+      values.begin(),
+      values.end(),
+      0,
+      [](int lhs, int rhs) { return lhs + rhs; },
+      square);
+    ASSERT_TRUE(result.has_error());
+}
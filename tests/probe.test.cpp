@@ -0,0 +1,119 @@
+// Standard includes
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+// POSIX includes
+#include <elf.h>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/optional.hpp"
+
+#if ! RES_PROBES_ENABLED
+#error "Probe tests must be compiled with RES_PROBES on a supported target."
+#endif
+
+namespace {
+
+res::optional_t<int> fail() {
+    return RES_NEW_ERROR("failed");
+}
+
+res::optional_t<int> propagate() {
+    return RES_TRACE(fail().error());
+}
+
+res::optional_t<int> annotate() {
+    return RES_ERROR(fail().error(), "annotated");
+}
+
+std::vector<char> read_executable() {
+    std::ifstream file{ "/proc/self/exe", std::ios::binary };
+    return std::vector<char>{ std::istreambuf_iterator<char>{ file },
+        std::istreambuf_iterator<char>{} };
+}
+
+// Map each probe name of the "res" provider to its argument string.
+std::map<std::string, std::string> read_probes() {
+    const std::vector<char> image = read_executable();
+    Elf64_Ehdr header;
+    std::memcpy(&header, image.data(), sizeof(header));
+
+    std::vector<Elf64_Shdr> sections(header.e_shnum);
+    std::memcpy(sections.data(), image.data() + header.e_shoff,
+      sizeof(Elf64_Shdr) * header.e_shnum);
+    const char* names = image.data() + sections[header.e_shstrndx].sh_offset;
+
+    std::map<std::string, std::string> probes;
+    for (const Elf64_Shdr& section : sections) {
+        if (std::strcmp(names + section.sh_name, ".note.stapsdt") != 0) {
+            continue;
+        }
+
+        std::size_t offset = section.sh_offset;
+        const std::size_t end = section.sh_offset + section.sh_size;
+        while (offset < end) {
+            Elf64_Nhdr note;
+            std::memcpy(&note, image.data() + offset, sizeof(note));
+            const std::size_t name_size = (note.n_namesz + 3U) & ~3U;
+            const char* description =
+              image.data() + offset + sizeof(note) + name_size;
+
+            // The description holds three addresses followed by the provider,
+            // probe name, and argument strings.
+            const char* provider = description + (3 * sizeof(std::uint64_t));
+            const char* probe = provider + std::strlen(provider) + 1;
+            const char* arguments = probe + std::strlen(probe) + 1;
+            if (std::string{ provider } == "res") {
+                probes[probe] = arguments;
+            }
+
+            offset += sizeof(note) + name_size + ((note.n_descsz + 3U) & ~3U);
+        }
+    }
+    return probes;
+}
+
+} // namespace
+
+TEST(probe_test, notes_exist) {
+    const std::map<std::string, std::string> probes = read_probes();
+    ASSERT_EQ(probes.count("new_error"), 1);
+    ASSERT_EQ(probes.count("trace"), 1);
+    ASSERT_EQ(probes.count("error"), 1);
+
+    // Every probe has five arguments.
+    for (const auto& [name, arguments] : probes) {
+        std::size_t count = 0;
+        for (const char character : arguments) {
+            count += (character == '@') ? 1 : 0;
+        }
+        ASSERT_EQ(count, 5) << name << ": " << arguments;
+    }
+}
+
+TEST(probe_test, semaphores) {
+    ASSERT_EQ(res::detail::new_error_semaphore, 0);
+    ASSERT_EQ(res::detail::trace_semaphore, 0);
+    ASSERT_EQ(res::detail::error_semaphore, 0);
+
+    // Simulate an attached tracer so that the argument setup runs.
+    res::detail::new_error_semaphore = 1;
+    res::detail::trace_semaphore = 1;
+    res::detail::error_semaphore = 1;
+    const std::string traced = propagate().error().string();
+    const std::string annotated = annotate().error().string();
+    res::detail::new_error_semaphore = 0;
+    res::detail::trace_semaphore = 0;
+    res::detail::error_semaphore = 0;
+
+    ASSERT_NE(traced.find("failed"), std::string::npos);
+    ASSERT_NE(annotated.find("annotated"), std::string::npos);
+}
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 
 // Local includes
+#include "../include/optional.hpp"
 #include "../include/result.hpp"
 
 TEST(result_test, result_default_constructor) {
@@ -119,3 +120,89 @@ TEST(result_test, result_success) {
 
     ASSERT_GT(result.error().string().size(), 0);
 }
+
+namespace {
+
+res::result_t check(bool value) {
+    if (! value) {
+        return RES_NEW_ERROR("check failed");
+    }
+    return res::success;
+}
+
+} // namespace
+
+TEST(result_test, result_and_then) {
+    res::result_t result;
+    ASSERT_TRUE(result.and_then([]() { return check(true); }).success());
+    ASSERT_TRUE(result.and_then([]() { return check(false); }).failure());
+    ASSERT_EQ(
+      result.and_then([]() -> res::optional_t<int> { return 3; }).value(), 3);
+
+    res::result_t failure = check(false);
+    const std::string expected = failure.error().string();
+    int calls = 0;
+    auto counted = [&calls]() {
+        ++calls;
+        return check(true);
+    };
+    ASSERT_EQ(failure.and_then(counted).error().string(), expected);
+    ASSERT_EQ(std::move(failure).and_then(counted).error().string(), expected);
+    ASSERT_EQ(calls, 0);
+}
+
+TEST(result_test, result_and_then_site) {
+    res::result_t failure = check(false);
+    const std::string expected = failure.error().string();
+    auto traced = failure.and_then([]() { return check(true); }, RES_SITE);
+    ASSERT_GT(traced.error().string().size(), expected.size());
+    ASSERT_EQ(traced.error().string().rfind(expected, 0), 0);
+}
+
+TEST(result_test, result_transform) {
+    res::result_t result;
+    ASSERT_EQ(result.transform([]() { return 5; }).value(), 5);
+    ASSERT_EQ(res::result_t{}.transform([]() { return 5; }).value(), 5);
+
+    res::result_t failure = check(false);
+    ASSERT_TRUE(failure.transform([]() { return 5; }).has_error());
+    ASSERT_TRUE(std::move(failure).transform([]() { return 5; }).has_error());
+}
+
+TEST(result_test, result_transform_void) {
+    int calls = 0;
+    auto count = [&calls]() { ++calls; };
+    const res::result_t result;
+    const res::optional_t<void> first = result.transform(count);
+    const res::optional_t<void> second = res::result_t{}.transform(count);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    ASSERT_EQ(calls, 2);
+
+    res::result_t failure = check(false);
+    ASSERT_TRUE(failure.transform(count).has_error());
+    ASSERT_TRUE(std::move(failure).transform(count).has_error());
+    ASSERT_EQ(calls, 2);
+}
+
+TEST(result_test, result_or_else) {
+    auto recover = [](const res::error_t&) { return res::result_t{}; };
+    res::result_t failure = check(false);
+    ASSERT_TRUE(failure.or_else(recover).success());
+    ASSERT_TRUE(std::move(failure).or_else(recover).success());
+
+    auto rethrow = [](res::error_t&& error) -> res::result_t {
+        return RES_TRACE(std::move(error));
+    };
+    ASSERT_TRUE(check(false).or_else(rethrow).failure());
+    ASSERT_TRUE(check(true).or_else(rethrow).success());
+}
+
+TEST(result_test, result_transform_error) {
+    auto replace = [](const res::error_t&) { return res::error_t{ "new" }; };
+    res::result_t failure = check(false);
+    ASSERT_EQ(failure.transform_error(replace).error().string(), "new");
+    ASSERT_EQ(
+      std::move(failure).transform_error(replace).error().string(), "new");
+    ASSERT_TRUE(check(true).transform_error(replace).success());
+}
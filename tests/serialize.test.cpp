@@ -0,0 +1,170 @@
+// Standard includes
+#include <random>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/serialize.hpp"
+
+namespace {
+
+std::vector<unsigned char> encode_all(const res::error_t& error,
+  std::optional<std::int64_t> code = std::nullopt) {
+    std::vector<unsigned char> buffer(res::encoded_size(error, code));
+    auto written = res::encode(error, buffer.data(), buffer.size(), code);
+    EXPECT_TRUE(written.has_value());
+    EXPECT_EQ(written.value(), buffer.size());
+    return buffer;
+}
+
+res::error_t nested_error() {
+    auto error = RES_NEW_ERROR("origin");
+    for (int depth = 0; depth < 8; ++depth) {
+        error = RES_TRACE(error);
+    }
+    return RES_CONCAT(
+      RES_ERROR(error, "annotated"), RES_NEW_ERROR("other\nmultiline"));
+}
+
+} // namespace
+
+TEST(serialize_test, round_trip) {
+    for (const res::error_t& error : { res::error_t{ "" },
+           res::error_t{ "\n" },
+           res::error_t{ "no trailing newline" },
+           res::error_t{ "\n\nblank lines\n\n" },
+           RES_NEW_ERROR(""),
+           nested_error() }) {
+        const auto buffer = encode_all(error);
+
+        res::error_view_t view;
+        ASSERT_TRUE(view.read(buffer.data(), buffer.size()).success());
+        ASSERT_EQ(view.size(), buffer.size());
+        ASSERT_FALSE(view.has_code());
+        ASSERT_EQ(view.string(), error.string());
+        ASSERT_EQ(view.to_error().string(), error.string());
+    }
+}
+
+TEST(serialize_test, round_trip_code) {
+    const auto buffer = encode_all(RES_NEW_ERROR("with code"), -42);
+
+    res::error_view_t view;
+    ASSERT_TRUE(view.read(buffer.data(), buffer.size()).success());
+    ASSERT_TRUE(view.has_code());
+    ASSERT_EQ(view.code(), -42);
+}
+
+TEST(serialize_test, frames) {
+    const auto buffer = encode_all(RES_TRACE(RES_NEW_ERROR("message")));
+
+    res::error_view_t view;
+    ASSERT_TRUE(view.read(buffer.data(), buffer.size()).success());
+    ASSERT_EQ(view.frame_count(), 2);
+
+    const res::frame_t origin = view.frame(0);
+    ASSERT_TRUE(origin.has_site);
+    ASSERT_TRUE(origin.has_message);
+    ASSERT_EQ(origin.function, "TestBody");
+    ASSERT_EQ(origin.message, "message");
+
+    const res::frame_t trace = view.frame(1);
+    ASSERT_TRUE(trace.has_site);
+    ASSERT_FALSE(trace.has_message);
+
+    // Views refer directly to the encoded bytes.
+    const auto* begin = reinterpret_cast<const char*>(buffer.data());
+    ASSERT_GE(origin.message.data(), begin);
+    ASSERT_LE(origin.message.data() + origin.message.size(),
+      begin + buffer.size());
+
+    size_t count = 0;
+    for (const res::frame_t frame : view) {
+        ASSERT_TRUE(frame.has_site);
+        ++count;
+    }
+    ASSERT_EQ(count, view.frame_count());
+}
+
+TEST(serialize_test, strings_are_interned) {
+    auto error = RES_NEW_ERROR("origin");
+    auto deep_error = error;
+    for (int depth = 0; depth < 100; ++depth) {
+        deep_error = RES_TRACE(deep_error);
+    }
+
+    ASSERT_LT(res::encoded_size(deep_error), deep_error.string().size());
+}
+
+TEST(serialize_test, buffer_too_small) {
+    const auto error = nested_error();
+    std::vector<unsigned char> buffer(res::encoded_size(error) - 1);
+    ASSERT_TRUE(res::encode(error, buffer.data(), buffer.size()).has_error());
+}
+
+TEST(serialize_test, trailing_bytes_ignored) {
+    const auto error = nested_error();
+    auto buffer = encode_all(error);
+    const size_t size = buffer.size();
+    buffer.resize(size * 2, 0xFF);
+
+    res::error_view_t view;
+    ASSERT_TRUE(view.read(buffer.data(), buffer.size()).success());
+    ASSERT_EQ(view.size(), size);
+    ASSERT_EQ(view.string(), error.string());
+}
+
+TEST(serialize_test, truncated) {
+    const auto buffer = encode_all(nested_error());
+    for (size_t size = 0; size < buffer.size(); ++size) {
+        res::error_view_t view;
+        ASSERT_TRUE(view.read(buffer.data(), size).failure()) << size;
+        ASSERT_EQ(view.frame_count(), 0);
+    }
+}
+
+TEST(serialize_test, unsupported_version) {
+    auto buffer = encode_all(nested_error());
+    buffer[3] = res::encoding_version + 1;
+
+    res::error_view_t view;
+    ASSERT_TRUE(view.read(buffer.data(), buffer.size()).failure());
+}
+
+TEST(serialize_test, corruption) {
+    const auto original = encode_all(nested_error(), 7);
+    std::mt19937 generator{ 1234 };
+
+    for (int iteration = 0; iteration < 20000; ++iteration) {
+        auto buffer = original;
+        std::uniform_int_distribution<size_t> position{ 0, buffer.size() - 1 };
+        std::uniform_int_distribution<int> byte{ 0, 255 };
+        const int flips = 1 + (iteration % 4);
+        for (int flip = 0; flip < flips; ++flip) {
+            buffer[position(generator)] =
+              static_cast<unsigned char>(byte(generator));
+        }
+
+        // A corrupt encoding must either be rejected or decode to frames
+        // that lie entirely within the buffer.
+        res::error_view_t view;
+        if (view.read(buffer.data(), buffer.size()).failure()) {
+            continue;
+        }
+        const auto* begin = reinterpret_cast<const char*>(buffer.data());
+        const auto* end = begin + buffer.size();
+        for (const res::frame_t frame : view) {
+            for (const std::string_view string :
+              { frame.file, frame.function, frame.message }) {
+                if (string.empty()) {
+                    continue;
+                }
+                ASSERT_GE(string.data(), begin);
+                ASSERT_LE(string.data() + string.size(), end);
+            }
+        }
+        (void)view.string();
+    }
+}
@@ -0,0 +1,91 @@
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/optional.hpp"
+#include "../include/stack.hpp"
+
+namespace {
+
+res::optional_t<int> fail() {
+    return RES_NEW_ERROR("failed");
+}
+
+std::size_t count_lines(const std::string& text) {
+    std::size_t count = 0;
+    for (const char character : text) {
+        count += (character == '\n') ? 1 : 0;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(stack_test, disabled_by_default) {
+    ASSERT_FALSE(res::stack_capture_enabled());
+
+    const auto result = fail();
+    ASSERT_TRUE(result.error().stack().empty());
+    ASSERT_TRUE(res::render_stack(result.error()).empty());
+}
+
+TEST(stack_test, capture) {
+    res::enable_stack_capture();
+    ASSERT_TRUE(res::stack_capture_enabled());
+    const auto result = fail();
+    res::enable_stack_capture(false);
+
+    const res::error_t error = result.error();
+    ASSERT_FALSE(error.stack().empty());
+    ASSERT_LE(error.stack().size(), res::max_stack_depth);
+
+    // The trace is unaffected by stack capture.
+    ASSERT_NE(error.string().find("failed"), std::string::npos);
+    ASSERT_EQ(count_lines(error.string()), 1);
+
+    const std::string rendered = res::render_stack(error);
+    ASSERT_EQ(count_lines(rendered), error.stack().size());
+    ASSERT_EQ(rendered.rfind("#0 0x", 0), 0);
+
+    // Traces preserve the captured stack.
+    const res::error_t copy = RES_TRACE(error);
+    ASSERT_EQ(copy.stack(), error.stack());
+}
+
+TEST(stack_test, symbol_cache) {
+    res::enable_stack_capture();
+    const auto result = fail();
+    res::enable_stack_capture(false);
+    const res::error_t error = result.error();
+
+    const std::string first = res::render_stack(error);
+    const std::size_t cached = res::symbol_cache_size();
+    ASSERT_GE(cached, 1);
+
+    // Rendering again resolves every address from the cache.
+    ASSERT_EQ(res::render_stack(error), first);
+    ASSERT_EQ(res::symbol_cache_size(), cached);
+}
+
+TEST(stack_test, frame_pointers) {
+    res::enable_stack_capture(true, res::stack_walk_t::frame_pointers);
+    ASSERT_TRUE(res::stack_capture_enabled());
+    const auto walked = fail();
+    res::enable_stack_capture(true, res::stack_walk_t::unwind);
+    const auto unwound = fail();
+    res::enable_stack_capture(false);
+
+    const std::vector<std::uintptr_t> stack = walked.error().stack();
+    ASSERT_FALSE(stack.empty());
+    ASSERT_LE(stack.size(), res::max_stack_depth);
+
+    // Both walks begin at the same return address. Frames further up are only
+    // found by the frame pointer walk if their callers keep frame pointers.
+    ASSERT_EQ(stack.front(), unwound.error().stack().front());
+}
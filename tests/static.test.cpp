@@ -0,0 +1,106 @@
+// Standard includes
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/static.hpp"
+
+namespace {
+
+constexpr res::static_optional_t<int> parse_int(std::string_view text) {
+    if (text.empty()) {
+        return res::static_error_t{ "empty integer" };
+    }
+
+    int value = 0;
+    for (const char digit : text) {
+        if (digit < '0' || digit > '9') {
+            return res::static_error_t{ "invalid digit" };
+        }
+        value = (value * 10) + (digit - '0');
+    }
+    return value;
+}
+
+constexpr res::static_result_t check_even(int value) {
+    if (value % 2 != 0) {
+        return res::static_error_t{ "odd" };
+    }
+    return {};
+}
+
+// A lookup table computed at compile time.
+constexpr std::array<std::string_view, 4> table_text{ "1", "22", "x", "" };
+constexpr auto table = [] {
+    std::array<res::static_optional_t<int>, table_text.size()> table{
+        res::static_error_t{ "" },
+        res::static_error_t{ "" },
+        res::static_error_t{ "" },
+        res::static_error_t{ "" },
+    };
+    for (std::size_t index = 0; index < table_text.size(); ++index) {
+        table[index] = parse_int(table_text[index]);
+    }
+    return table;
+}();
+
+} // namespace
+
+static_assert(parse_int("1234").has_value());
+static_assert(parse_int("1234").value() == 1234);
+static_assert(! parse_int("1234").has_error());
+static_assert(parse_int("12a").has_error());
+static_assert(parse_int("12a").error().message() == "invalid digit");
+static_assert(parse_int("").error().message() == "empty integer");
+static_assert(parse_int("x").value_or(-1) == -1);
+static_assert(parse_int("1234").error().message() == "Has value");
+
+static_assert(check_even(2).success());
+static_assert(check_even(3).failure());
+static_assert(check_even(3).error().message() == "odd");
+static_assert(check_even(2).error().message() == "Success");
+
+static_assert(table[0].value() == 1);
+static_assert(table[1].value() == 22);
+static_assert(table[2].error().message() == "invalid digit");
+static_assert(table[3].error().message() == "empty integer");
+
+#if defined(__cpp_lib_constexpr_string) && __cpp_lib_constexpr_string >= 201907L
+static_assert(res::error_t{ "message" }.string() == "message");
+#endif
+
+TEST(static_test, runtime_access) {
+    const auto value = parse_int("42");
+    ASSERT_EQ(value.value(), 42);
+
+    const auto error = parse_int("?");
+    ASSERT_THROW((void)error.value(), res::bad_optional_access_t);
+    ASSERT_EQ(error.error().to_error().string(), "invalid digit");
+}
+
+TEST(static_test, optional_conversion) {
+    const res::optional_t<int> value = parse_int("42");
+    ASSERT_EQ(value.value(), 42);
+
+    const res::optional_t<int> error = parse_int("?");
+    ASSERT_TRUE(error.has_error());
+    ASSERT_EQ(error.error().string(), "invalid digit");
+
+    // Tables computed at compile time convert as well.
+    const res::optional_t<int> entry = table[2];
+    ASSERT_EQ(entry.error().string(), "invalid digit");
+}
+
+TEST(static_test, result_conversion) {
+    res::result_t success = check_even(4);
+    ASSERT_TRUE(success.success());
+
+    res::result_t failure = check_even(5);
+    ASSERT_TRUE(failure.failure());
+    ASSERT_EQ(failure.error().string(), "odd");
+}
@@ -0,0 +1,111 @@
+// Standard includes
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/optional.hpp"
+#include "../include/timeline.hpp"
+
+namespace {
+
+res::optional_t<int> fail() {
+    return RES_NEW_ERROR("failed \"quoted\"");
+}
+
+res::optional_t<int> propagate() {
+    return RES_TRACE(fail().error());
+}
+
+std::size_t count(const std::string& text, std::string_view pattern) {
+    std::size_t count = 0;
+    for (std::size_t position = text.find(pattern);
+      position != std::string::npos;
+      position = text.find(pattern, position + pattern.size())) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(timeline_test, disabled_by_default) {
+    ASSERT_FALSE(res::frame_timing_enabled());
+    ASSERT_TRUE(propagate().error().timeline().empty());
+}
+
+TEST(timeline_test, records_frames) {
+    res::enable_frame_timing();
+    ASSERT_TRUE(res::frame_timing_enabled());
+    const res::error_t error = propagate().error();
+    res::enable_frame_timing(false);
+
+    const auto& timeline = error.timeline();
+    ASSERT_EQ(timeline.size(), 2);
+    ASSERT_EQ(timeline[0].site.function, "fail");
+    ASSERT_EQ(timeline[1].site.function, "propagate");
+    ASSERT_LE(timeline[0].timestamp, timeline[1].timestamp);
+    ASSERT_EQ(timeline[0].thread, timeline[1].thread);
+}
+
+TEST(timeline_test, records_threads) {
+    res::enable_frame_timing();
+    res::error_t error = fail().error();
+    std::thread thread{ [&error] { error = RES_TRACE(std::move(error)); } };
+    thread.join();
+    res::enable_frame_timing(false);
+
+    const auto& timeline = error.timeline();
+    ASSERT_EQ(timeline.size(), 2);
+    ASSERT_NE(timeline[0].thread, timeline[1].thread);
+}
+
+TEST(timeline_test, chrome_trace) {
+    res::enable_frame_timing();
+    const std::vector<res::error_t> errors{ propagate().error(),
+        res::error_t{ "untimed" }, fail().error() };
+    res::enable_frame_timing(false);
+
+    std::ostringstream stream;
+    ASSERT_TRUE(res::write_chrome_trace(stream, errors).success());
+    const std::string json = stream.str();
+
+    // One slice per timed error and one instant event per timed frame.
+    ASSERT_EQ(json.rfind("{\"traceEvents\":[", 0), 0);
+    ASSERT_EQ(count(json, "\"ph\":\"X\""), 2);
+    ASSERT_EQ(count(json, "\"ph\":\"i\""), 3);
+    ASSERT_EQ(count(json, "\"name\":\"error 0\""), 1);
+    ASSERT_EQ(count(json, "\"name\":\"error 1\""), 0);
+    ASSERT_EQ(count(json, "\"name\":\"error 2\""), 1);
+
+    // Messages are escaped.
+    ASSERT_NE(json.find("failed \\\"quoted\\\"\\n"), std::string::npos);
+    ASSERT_EQ(json.find("untimed"), std::string::npos);
+}
+
+TEST(timeline_test, chrome_trace_empty) {
+    ASSERT_EQ(res::chrome_trace({}),
+      "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+TEST(timeline_test, bounded_by_trace_limit) {
+    res::set_trace_limit(res::trace_limit_t{ 1, 2 });
+    res::enable_frame_timing();
+    res::error_t error = fail().error();
+    for (int frame = 0; frame < 10; ++frame) {
+        error = RES_TRACE(std::move(error));
+    }
+    res::enable_frame_timing(false);
+    res::set_trace_limit(res::trace_limit_t{});
+
+    const auto& timeline = error.timeline();
+    ASSERT_EQ(timeline.size(), 3);
+    ASSERT_EQ(timeline[0].site.function, "fail");
+    ASSERT_LE(timeline[1].timestamp, timeline[2].timestamp);
+    ASSERT_EQ(error.elided_frames(), 8);
+}
@@ -0,0 +1,60 @@
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../include/error.hpp"
+#include "../include/trace.hpp"
+
+TEST(trace_test, parse_frame_with_message) {
+    const res::frame_t frame =
+      res::parse_frame("src/main.cpp:func():42 -> oops");
+    ASSERT_TRUE(frame.has_site);
+    ASSERT_TRUE(frame.has_message);
+    ASSERT_EQ(frame.file, "src/main.cpp");
+    ASSERT_EQ(frame.function, "func");
+    ASSERT_EQ(frame.line, 42);
+    ASSERT_EQ(frame.message, "oops");
+}
+
+TEST(trace_test, parse_frame_without_message) {
+    const res::frame_t frame = res::parse_frame("main.cpp:operator()():7");
+    ASSERT_TRUE(frame.has_site);
+    ASSERT_FALSE(frame.has_message);
+    ASSERT_EQ(frame.file, "main.cpp");
+    ASSERT_EQ(frame.function, "operator()");
+    ASSERT_EQ(frame.line, 7);
+}
+
+TEST(trace_test, parse_frame_with_drive_letter) {
+    const res::frame_t frame = res::parse_frame("C:\\src\\main.cpp:func():1");
+    ASSERT_TRUE(frame.has_site);
+    ASSERT_EQ(frame.file, "C:\\src\\main.cpp");
+    ASSERT_EQ(frame.function, "func");
+}
+
+TEST(trace_test, parse_frame_text) {
+    for (const char* line : { "", "plain text", "a:b():", "a:b():01",
+           "a:b():1x", ":b():1", "a:():1" }) {
+        const res::frame_t frame = res::parse_frame(line);
+        ASSERT_FALSE(frame.has_site) << line;
+        ASSERT_TRUE(frame.has_message) << line;
+        ASSERT_EQ(frame.message, line);
+    }
+}
+
+TEST(trace_test, render_frame_matches_macros) {
+    const res::error_t error =
+      RES_TRACE(RES_ERROR(RES_NEW_ERROR("first"), "second"));
+
+    std::string rendered;
+    res::for_each_line(error.string(), [&rendered](std::string_view line) {
+        res::render_frame(rendered, res::parse_frame(line)).push_back('\n');
+    });
+    ASSERT_EQ(rendered, error.string());
+}
+
+TEST(trace_test, for_each_line_count) {
+    size_t count = 0;
+    res::for_each_line("a\n\nb\n", [&count](std::string_view) { ++count; });
+    ASSERT_EQ(count, 3);
+}